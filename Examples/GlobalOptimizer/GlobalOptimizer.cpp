@@ -208,7 +208,10 @@ void testFirefly() {
     std::cout << "Function eggholder, Agents: " << agents
             << ", Vola: " << vola << ", Intensity: " << intense << std::endl;
     TestFunction f(eggholder);
-    FireflyAlgorithm fa(agents, intensity, randomWalk, 40);
+    // the test functions are thread-safe, so the agents can be
+    // evaluated in parallel if OpenMP is enabled
+    FireflyAlgorithm fa(agents, intensity, randomWalk, 40, 1.0, 0.5,
+                        seed, true);
     EndCriteria ec(5000, 1000, 1.0e-8, 1.0e-8, 1.0e-8);
     test(fa, f, ec, x, constraint, optimum);
     std::cout << "================================================================" << std::endl;
@@ -317,7 +320,8 @@ void testPSO(Size n){
     boost::shared_ptr<ParticleSwarmOptimization::Inertia> inertia =
         boost::make_shared<LevyFlightInertia>(1.5, threshold, seed);
     TestFunction f(rosenbrock);
-    ParticleSwarmOptimization pso(agents, topology, inertia, 2.05, 2.05, seed);
+    ParticleSwarmOptimization pso(agents, topology, inertia, 2.05, 2.05,
+                                  seed, true);
     EndCriteria ec(10000, 1000, 1.0e-8, 1.0e-8, 1.0e-8);
     test(pso, f, ec, x, constraint, optimum);
     std::cout << "================================================================" << std::endl;
@@ -347,7 +351,8 @@ void testDifferentialEvolution(Size n, Size agents){
           .withPopulationMembers(agents)
           .withStepsizeWeight(stepsizeWeight)
           .withStrategy(strategy)
-          .withSeed(seed);
+          .withSeed(seed)
+          .withParallelEvaluation();
 
     DifferentialEvolution de(config);
     EndCriteria ec(5000, 1000, 1.0e-8, 1.0e-8, 1.0e-8);
@@ -23,6 +23,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #endif
 #include <ql/experimental/math/multidimintegrator.hpp>
 #include <ql/experimental/math/multidimquadrature.hpp>
+#include <ql/experimental/math/sparsegridquadrature.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 
 #include <boost/function.hpp>
@@ -79,6 +80,13 @@ int main() {
     Real secondsQuad = timer.elapsed();
     #endif
 
+    // the sparse grid pays off in higher dimensions; see its docs
+    SparseGridGaussHermiteIntegrator sparseIntg(dimension, 9);
+
+    timer.restart();
+    Real valueSparse = sparseIntg(f);
+    Real secondsSparse = timer.elapsed();
+
     std::vector<boost::shared_ptr<Integrator> > integrals;
     for(Size i=0; i<dimension; i++)
         integrals.push_back(
@@ -97,6 +105,7 @@ int main() {
         #ifndef QL_PATCH_SOLARIS
          << "Quad: " << valueQuad << endl
         #endif
+         << "Sparse: " << valueSparse << endl
          << "Grid: " << valueGrid << endl
          << endl;
 
@@ -104,6 +113,8 @@ int main() {
         #ifndef QL_PATCH_SOLARIS
         << "Seconds for Quad: " << secondsQuad << endl
         #endif
+        << "Seconds for Sparse: " << secondsSparse
+        << " (" << sparseIntg.size() << " nodes)" << endl
         << "Seconds for Grid: " << secondsGrid << endl;
     return 0;
 }
@@ -418,25 +418,59 @@ namespace QuantLib {
                               public Visitor<CashFlow>,
                               public Visitor<Coupon> {
           public:
-            BPSCalculator(const YieldTermStructure& discountCurve)
-            : discountCurve_(discountCurve), bps_(0.0), nonSensNPV_(0.0) {}
+            BPSCalculator()
+            : discount_(1.0), bps_(0.0), nonSensNPV_(0.0) {}
+            // to be set before visiting each cash flow
+            void setDiscount(DiscountFactor discount) {
+                discount_ = discount;
+            }
             void visit(Coupon& c) {
                 Real bps = c.nominal() *
                            c.accrualPeriod() *
-                           discountCurve_.discount(c.date());
+                           discount_;
                 bps_ += bps;
             }
             void visit(CashFlow& cf) {
-                nonSensNPV_ += cf.amount() * 
-                               discountCurve_.discount(cf.date());
+                nonSensNPV_ += cf.amount() * discount_;
             }
             Real bps() const { return bps_; }
             Real nonSensNPV() const { return nonSensNPV_; }
           private:
-            const YieldTermStructure& discountCurve_;
+            DiscountFactor discount_;
             Real bps_, nonSensNPV_;
         };
 
+        // the cash flows still to be paid and their discount
+        // factors, which are retrieved from the curve in a single call
+        class AliveCashFlows {
+          public:
+            AliveCashFlows(const Leg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           const Date& settlementDate) {
+                std::vector<Date> dates;
+                dates.reserve(leg.size());
+                indexes_.reserve(leg.size());
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (!leg[i]->hasOccurred(settlementDate,
+                                             includeSettlementDateFlows) &&
+                        !leg[i]->tradingExCoupon(settlementDate)) {
+                        indexes_.push_back(i);
+                        dates.push_back(leg[i]->date());
+                    }
+                }
+                discounts_.resize(dates.size());
+                if (!dates.empty())
+                    discountCurve.discounts(dates, &discounts_[0]);
+            }
+            Size size() const { return indexes_.size(); }
+            Size index(Size i) const { return indexes_[i]; }
+            DiscountFactor discount(Size i) const { return discounts_[i]; }
+          private:
+            std::vector<Size> indexes_;
+            std::vector<DiscountFactor> discounts_;
+        };
+
         const Spread basisPoint_ = 1.0e-4;
     } // anonymous namespace ends here
 
@@ -455,14 +489,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
+        AliveCashFlows flows(leg, discountCurve,
+                             includeSettlementDateFlows, settlementDate);
         Real totalNPV = 0.0;
-        for (Size i=0; i<leg.size(); ++i) {
-            if (!leg[i]->hasOccurred(settlementDate,
-                                     includeSettlementDateFlows) &&
-                !leg[i]->tradingExCoupon(settlementDate))
-                totalNPV += leg[i]->amount() *
-                            discountCurve.discount(leg[i]->date());
-        }
+        for (Size i=0; i<flows.size(); ++i)
+            totalNPV += leg[flows.index(i)]->amount() * flows.discount(i);
 
         return totalNPV/discountCurve.discount(npvDate);
     }
@@ -481,12 +512,12 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        BPSCalculator calc(discountCurve);
-        for (Size i=0; i<leg.size(); ++i) {
-            if (!leg[i]->hasOccurred(settlementDate,
-                                     includeSettlementDateFlows) &&
-                !leg[i]->tradingExCoupon(settlementDate))
-                leg[i]->accept(calc);
+        AliveCashFlows flows(leg, discountCurve,
+                             includeSettlementDateFlows, settlementDate);
+        BPSCalculator calc;
+        for (Size i=0; i<flows.size(); ++i) {
+            calc.setDiscount(flows.discount(i));
+            leg[flows.index(i)]->accept(calc);
         }
         return basisPoint_*calc.bps()/discountCurve.discount(npvDate);
     }
@@ -500,23 +531,20 @@ namespace QuantLib {
                            Real& bps) {
 
         npv = 0.0;
-        if (leg.empty()) {
-            bps = 0.0;
+        bps = 0.0;
+        if (leg.empty())
             return;
-        }
 
-        for (Size i=0; i<leg.size(); ++i) {
-            CashFlow& cf = *leg[i];
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                boost::shared_ptr<Coupon> cp =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                Real df = discountCurve.discount(cf.date());
-                npv += cf.amount() * df;
-                if(cp != NULL)
-                    bps += cp->nominal() * cp->accrualPeriod() * df;
-            }
+        AliveCashFlows flows(leg, discountCurve,
+                             includeSettlementDateFlows, settlementDate);
+        for (Size i=0; i<flows.size(); ++i) {
+            const boost::shared_ptr<CashFlow>& cf = leg[flows.index(i)];
+            boost::shared_ptr<Coupon> cp =
+                boost::dynamic_pointer_cast<Coupon>(cf);
+            Real df = flows.discount(i);
+            npv += cf->amount() * df;
+            if(cp != NULL)
+                bps += cp->nominal() * cp->accrualPeriod() * df;
         }
         DiscountFactor d = discountCurve.discount(npvDate);
         npv /= d;
@@ -536,17 +564,15 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
+        AliveCashFlows flows(leg, discountCurve,
+                             includeSettlementDateFlows, settlementDate);
         Real npv = 0.0;
-        BPSCalculator calc(discountCurve);
-        for (Size i=0; i<leg.size(); ++i) {
-            CashFlow& cf = *leg[i];
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                npv += cf.amount() *
-                       discountCurve.discount(cf.date());
-                cf.accept(calc);
-            }
+        BPSCalculator calc;
+        for (Size i=0; i<flows.size(); ++i) {
+            CashFlow& cf = *leg[flows.index(i)];
+            npv += cf.amount() * flows.discount(i);
+            calc.setDiscount(flows.discount(i));
+            cf.accept(calc);
         }
 
         if (targetNpv==Null<Real>())
@@ -760,34 +786,113 @@ namespace QuantLib {
                                     bool includeSettlementDateFlows,
                                     Date settlementDate,
                                     Date npvDate)
-    : leg_(leg), npv_(npv),
-      dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
-      includeSettlementDateFlows_(includeSettlementDateFlows),
-      settlementDate_(settlementDate),
-      npvDate_(npvDate) {
+    : npv_(npv),
+      dayCounter_(dayCounter), compounding_(comp), frequency_(freq) {
 
-        if (settlementDate_ == Date())
-            settlementDate_ = Settings::instance().evaluationDate();
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
 
-        if (npvDate_ == Date())
-            npvDate_ = settlementDate_;
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // the amounts and the year fractions between consecutive
+        // payments don't depend on the yield; they are calculated
+        // here once and for all.
+        amounts_.reserve(leg.size());
+        periods_.reserve(leg.size());
+        Date lastDate = npvDate;
+        Date refStartDate, refEndDate;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate,
+                                    includeSettlementDateFlows))
+                continue;
+
+            Date couponDate = leg[i]->date();
+            Real amount = leg[i]->amount();
+            if (leg[i]->tradingExCoupon(settlementDate)) {
+                amount = 0.0;
+            }
+
+            shared_ptr<Coupon> coupon =
+                boost::dynamic_pointer_cast<Coupon>(leg[i]);
+            if (coupon) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = couponDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = couponDate;
+            }
+            amounts_.push_back(amount);
+            periods_.push_back(dayCounter_.yearFraction(lastDate, couponDate,
+                                                        refStartDate,
+                                                        refEndDate));
+            lastDate = couponDate;
+        }
 
         checkSign();
     }
 
     Real CashFlows::IrrFinder::operator()(Rate y) const {
+        // same as CashFlows::npv; the discount is compounded period
+        // by period.
         InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        Real NPV = CashFlows::npv(leg_, yield,
-                                  includeSettlementDateFlows_,
-                                  settlementDate_, npvDate_);
+        Real NPV = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size i=0; i<amounts_.size(); ++i) {
+            discount *= yield.discountFactor(periods_[i]);
+            NPV += amounts_[i] * discount;
+        }
         return npv_ - NPV;
     }
 
     Real CashFlows::IrrFinder::derivative(Rate y) const {
+        // exact derivative of operator(), calculated in the same way;
+        // dlogB is the derivative of the log of the discount factor
+        // from the NPV date to the current payment.
         InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        return modifiedDuration(leg_, yield,
-                                includeSettlementDateFlows_,
-                                settlementDate_, npvDate_);
+        Real N = frequency_;
+        Real dNPVdy = 0.0;
+        DiscountFactor discount = 1.0;
+        Real dlogB = 0.0;
+        for (Size i=0; i<amounts_.size(); ++i) {
+            Time t = periods_[i];
+            DiscountFactor B = yield.discountFactor(t);
+            discount *= B;
+            switch (compounding_) {
+              case Simple:
+                dlogB -= t * B;
+                break;
+              case Compounded:
+                dlogB -= t/(1.0+y/N);
+                break;
+              case Continuous:
+                dlogB -= t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    dlogB -= t * B;
+                else
+                    dlogB -= t/(1.0+y/N);
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    dlogB -= t * B;
+                else
+                    dlogB -= t/(1.0+y/N);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(compounding_) << ")");
+            }
+            dNPVdy += amounts_[i] * discount * dlogB;
+        }
+        return -dNPVdy;
     }
 
     void CashFlows::IrrFinder::checkSign() const {
@@ -797,17 +902,14 @@ namespace QuantLib {
 
         Integer lastSign = sign(-npv_),
                 signChanges = 0;
-        for (Size i = 0; i < leg_.size(); ++i) {
-            if (!leg_[i]->hasOccurred(settlementDate_,
-                                      includeSettlementDateFlows_) &&
-                !leg_[i]->tradingExCoupon(settlementDate_)) {
-                Integer thisSign = sign(leg_[i]->amount());
-                if (lastSign * thisSign < 0) // sign change
-                    signChanges++;
-
-                if (thisSign != 0)
-                    lastSign = thisSign;
-            }
+        for (Size i = 0; i < amounts_.size(); ++i) {
+            // flows trading ex-coupon have a null amount and no sign
+            Integer thisSign = sign(amounts_[i]);
+            if (lastSign * thisSign < 0) // sign change
+                signChanges++;
+
+            if (thisSign != 0)
+                lastSign = thisSign;
         }
         QL_REQUIRE(signChanges > 0,
                    "the given cash flows cannot result in the given market "
@@ -964,6 +1066,66 @@ namespace QuantLib {
                                             accuracy, guess);
     }
 
+    std::vector<Rate> CashFlows::yields(
+                                   const std::vector<Leg>& legs,
+                                   const std::vector<Real>& npvs,
+                                   const DayCounter& dayCounter,
+                                   Compounding compounding,
+                                   Frequency frequency,
+                                   bool includeSettlementDateFlows,
+                                   const std::vector<Date>& settlementDates,
+                                   const std::vector<Date>& npvDates,
+                                   Real accuracy,
+                                   Size maxIterations,
+                                   Rate guess) {
+        Size n = legs.size();
+        QL_REQUIRE(npvs.size() == n,
+                   "wrong number of NPVs (" << npvs.size()
+                   << ") given for " << n << " legs");
+        QL_REQUIRE(settlementDates.empty() || settlementDates.size() == n,
+                   "wrong number of settlement dates ("
+                   << settlementDates.size() << ") given for "
+                   << n << " legs");
+        QL_REQUIRE(npvDates.empty() || npvDates.size() == n,
+                   "wrong number of NPV dates (" << npvDates.size()
+                   << ") given for " << n << " legs");
+
+        // the cash flows are not thread-safe (floating-rate coupons
+        // might call their pricers) so their amounts are retrieved
+        // here; the finders only work on their own copies.
+        std::vector<IrrFinder> finders;
+        finders.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            Date settlementDate =
+                settlementDates.empty() ? Date() : settlementDates[i];
+            Date npvDate = npvDates.empty() ? Date() : npvDates[i];
+            finders.push_back(IrrFinder(legs[i], npvs[i], dayCounter,
+                                        compounding, frequency,
+                                        includeSettlementDateFlows,
+                                        settlementDate, npvDate));
+        }
+
+        std::vector<Rate> results(n);
+        std::vector<std::string> errors(n);
+        #pragma omp parallel for default(shared)
+        for (Size i=0; i<n; ++i) {
+            // exceptions can't be propagated out of a parallel loop
+            try {
+                NewtonSafe solver;
+                solver.setMaxEvaluations(maxIterations);
+                results[i] = solver.solve(finders[i], accuracy,
+                                          guess, guess/10.0);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "yield calculation failed for leg #" << i+1
+                       << ": " << errors[i]);
+        return results;
+    }
+
 
     Time CashFlows::duration(const Leg& leg,
                              const InterestRate& rate,
@@ -1219,38 +1381,51 @@ namespace QuantLib {
                           bool includeSettlementDateFlows,
                           Date settlementDate,
                           Date npvDate)
-            : leg_(leg), npv_(npv), zSpread_(new SimpleQuote(0.0)),
+            : npv_(npv), zSpread_(new SimpleQuote(0.0)),
               curve_(Handle<YieldTermStructure>(discountCurve),
-                     Handle<Quote>(zSpread_), comp, freq, dc),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
+                     Handle<Quote>(zSpread_), comp, freq, dc) {
 
-                if (settlementDate_ == Date())
-                    settlementDate_ = Settings::instance().evaluationDate();
+                if (settlementDate == Date())
+                    settlementDate = Settings::instance().evaluationDate();
 
-                if (npvDate_ == Date())
-                    npvDate_ = settlementDate_;
+                if (npvDate == Date())
+                    npvDate = settlementDate;
 
                 // if the discount curve allows extrapolation, let's
                 // the spreaded curve do too.
                 curve_.enableExtrapolation(
                                   discountCurve->allowsExtrapolation());
+
+                // same flows as in CashFlows::npv; their amounts don't
+                // depend on the spread and are retrieved only once.
+                // The NPV date is stored last, so that all discounts
+                // are retrieved together.
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (!leg[i]->hasOccurred(settlementDate,
+                                             includeSettlementDateFlows) &&
+                        !leg[i]->tradingExCoupon(settlementDate)) {
+                        amounts_.push_back(leg[i]->amount());
+                        dates_.push_back(leg[i]->date());
+                    }
+                }
+                dates_.push_back(npvDate);
+                discounts_.resize(dates_.size());
             }
             Real operator()(Rate zSpread) const {
                 zSpread_->setValue(zSpread);
-                Real NPV = CashFlows::npv(leg_, curve_,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
-                return npv_ - NPV;
+                curve_.discounts(dates_, &discounts_[0]);
+                Real NPV = 0.0;
+                for (Size i=0; i<amounts_.size(); ++i)
+                    NPV += amounts_[i] * discounts_[i];
+                return npv_ - NPV/discounts_.back();
             }
           private:
-            const Leg& leg_;
             Real npv_;
             shared_ptr<SimpleQuote> zSpread_;
             ZeroSpreadedTermStructure curve_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
+            std::vector<Real> amounts_;
+            std::vector<Date> dates_;
+            mutable std::vector<DiscountFactor> discounts_;
         };
 
     } // anonymous namespace ends here
@@ -59,13 +59,12 @@ namespace QuantLib {
           private:
             void checkSign() const;
 
-            const Leg& leg_;
             Real npv_;
             DayCounter dayCounter_;
             Compounding compounding_;
             Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
+            std::vector<Real> amounts_;
+            std::vector<Time> periods_;
         };
       public:
         //! \name Date functions
@@ -289,6 +288,24 @@ namespace QuantLib {
                                   settlementDate, npvDate);
             return solver.solve(objFunction, accuracy, guess, guess/10.0);
         }
+        //! Implied internal rates of return of several legs.
+        /*! The amounts and payment times of all the legs are
+            retrieved first; the IRRs are then solved independently,
+            in parallel if OpenMP is enabled.  Empty vectors of
+            settlement or NPV dates are equivalent to null dates.
+        */
+        static std::vector<Rate> yields(
+                                   const std::vector<Leg>& legs,
+                                   const std::vector<Real>& npvs,
+                                   const DayCounter& dayCounter,
+                                   Compounding compounding,
+                                   Frequency frequency,
+                                   bool includeSettlementDateFlows,
+                                   const std::vector<Date>& settlementDates,
+                                   const std::vector<Date>& npvDates,
+                                   Real accuracy = 1.0e-10,
+                                   Size maxIterations = 100,
+                                   Rate guess = 0.05);
 
         //! Cash-flow duration.
         /*! The simple duration of a string of cash flows is defined as
@@ -0,0 +1,527 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2017 The QuantLib contributors
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/settings.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        // discount factors of the z-spreaded curve, as returned by
+        // ZeroSpreadedTermStructure, given those of the original one
+        class SpreadedDiscounts {
+          public:
+            SpreadedDiscounts(const YieldTermStructure& discountCurve,
+                              const std::vector<Date>& dates,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency)
+            : dayCounter_(dayCounter), compounding_(compounding),
+              frequency_(frequency), times_(dates.size()),
+              rates_(dates.size()) {
+                for (Size i=0; i<dates.size(); ++i)
+                    times_[i] = discountCurve.timeFromReference(dates[i]);
+                std::vector<DiscountFactor> discounts(dates.size());
+                discountCurve.discounts(times_, &discounts[0]);
+                for (Size i=0; i<times_.size(); ++i) {
+                    if (compounding_ == Continuous) {
+                        // the spread can be applied to the discount
+                        rates_[i] = discounts[i];
+                    } else if (times_[i] != 0.0) {
+                        rates_[i] = InterestRate::impliedRate(
+                                         1.0/discounts[i], dayCounter_,
+                                         compounding_, frequency_,
+                                         times_[i]).rate();
+                    }
+                }
+            }
+            DiscountFactor discount(Size i, Spread zSpread) const {
+                if (times_[i] == 0.0)
+                    return 1.0;
+                if (compounding_ == Continuous)
+                    return rates_[i] * std::exp(-zSpread*times_[i]);
+                InterestRate r(rates_[i] + zSpread, dayCounter_,
+                               compounding_, frequency_);
+                return r.discountFactor(times_[i]);
+            }
+          private:
+            DayCounter dayCounter_;
+            Compounding compounding_;
+            Frequency frequency_;
+            std::vector<Time> times_;
+            // zero rates, or discount factors for continuous compounding
+            std::vector<Real> rates_;
+        };
+
+        // the last discount is the one at the NPV date
+        Real spreadedNpv(const std::vector<Real>& amounts,
+                         const SpreadedDiscounts& discounts,
+                         Spread zSpread) {
+            Size n = amounts.size();
+            Real npv = 0.0;
+            for (Size i=0; i<n; ++i)
+                npv += amounts[i] * discounts.discount(i, zSpread);
+            return npv/discounts.discount(n, zSpread);
+        }
+
+        class ZSpreadFinder : public std::unary_function<Rate, Real> {
+          public:
+            ZSpreadFinder(const std::vector<Real>& amounts,
+                          const SpreadedDiscounts& discounts,
+                          Real npv)
+            : amounts_(amounts), discounts_(discounts), npv_(npv) {}
+            Real operator()(Spread zSpread) const {
+                return npv_ - spreadedNpv(amounts_, discounts_, zSpread);
+            }
+          private:
+            const std::vector<Real>& amounts_;
+            const SpreadedDiscounts& discounts_;
+            Real npv_;
+        };
+
+    }
+
+    CompiledLeg::CompiledLeg(const Leg& leg)
+    : leg_(leg) {
+        for (Leg::const_iterator i=leg_.begin(); i!=leg_.end(); ++i)
+            registerWith(*i);
+    }
+
+    void CompiledLeg::performCalculations() const {
+        Size n = leg_.size();
+        dates_.resize(n);
+        exCouponDates_.resize(n);
+        refPeriodStarts_.resize(n);
+        refPeriodEnds_.resize(n);
+        amounts_.resize(n);
+        nominals_.resize(n);
+        accrualPeriods_.resize(n);
+        rates_.resize(n);
+        isCoupon_.resize(n);
+        // amounts and rates might need fixings; they're retrieved
+        // only when needed
+        evaluated_.assign(n, false);
+        for (Size i=0; i<n; ++i) {
+            const boost::shared_ptr<CashFlow>& cf = leg_[i];
+            dates_[i] = cf->date();
+            exCouponDates_[i] = cf->exCouponDate();
+            boost::shared_ptr<Coupon> coupon =
+                boost::dynamic_pointer_cast<Coupon>(cf);
+            isCoupon_[i] = (coupon != 0);
+            if (coupon) {
+                refPeriodStarts_[i] = coupon->referencePeriodStart();
+                refPeriodEnds_[i] = coupon->referencePeriodEnd();
+                nominals_[i] = coupon->nominal();
+                accrualPeriods_[i] = coupon->accrualPeriod();
+            } else {
+                refPeriodStarts_[i] = refPeriodEnds_[i] = Date();
+                nominals_[i] = accrualPeriods_[i] = rates_[i] = 0.0;
+            }
+        }
+    }
+
+    void CompiledLeg::aliveFlows(bool includeSettlementDateFlows,
+                                 const Date& settlementDate,
+                                 bool skipExCoupon,
+                                 std::vector<Size>& indexes) const {
+        // same logic as CashFlow::hasOccurred and
+        // CashFlow::tradingExCoupon, resolved once for all flows
+        bool includeRefDate = includeSettlementDateFlows;
+        if (settlementDate == Settings::instance().evaluationDate()) {
+            boost::optional<bool> includeToday =
+                Settings::instance().includeTodaysCashFlows();
+            if (includeToday)
+                includeRefDate = *includeToday;
+        }
+        indexes.clear();
+        indexes.reserve(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i) {
+            bool occurred = includeRefDate ? dates_[i] < settlementDate
+                                           : dates_[i] <= settlementDate;
+            if (occurred)
+                continue;
+            if (skipExCoupon && tradingExCoupon(i, settlementDate))
+                continue;
+            indexes.push_back(i);
+        }
+    }
+
+    void CompiledLeg::yieldPeriods(const DayCounter& dc,
+                                   bool includeSettlementDateFlows,
+                                   const Date& settlementDate,
+                                   const Date& npvDate,
+                                   std::vector<Real>& amounts,
+                                   std::vector<Time>& periods) const {
+        std::vector<Size> alive;
+        aliveFlows(includeSettlementDateFlows, settlementDate, false, alive);
+        amounts.resize(alive.size());
+        periods.resize(alive.size());
+        Date lastDate = npvDate;
+        Date refStartDate, refEndDate;
+        for (Size j=0; j<alive.size(); ++j) {
+            Size i = alive[j];
+            const Date& couponDate = dates_[i];
+            if (tradingExCoupon(i, settlementDate)) {
+                amounts[j] = 0.0;
+            } else {
+                evaluate(i);
+                amounts[j] = amounts_[i];
+            }
+            if (isCoupon_[i]) {
+                refStartDate = refPeriodStarts_[i];
+                refEndDate = refPeriodEnds_[i];
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = couponDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = couponDate;
+            }
+            periods[j] = dc.yearFraction(lastDate, couponDate,
+                                         refStartDate, refEndDate);
+            lastDate = couponDate;
+        }
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        Real npv, bps;
+        npvbps(discountCurve, includeSettlementDateFlows,
+               settlementDate, npvDate, npv, bps);
+        return npv;
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        Real npv, bps;
+        npvbps(discountCurve, includeSettlementDateFlows,
+               settlementDate, npvDate, npv, bps);
+        return bps;
+    }
+
+    void CompiledLeg::npvbps(const YieldTermStructure& discountCurve,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate,
+                             Real& npv,
+                             Real& bps) const {
+        npv = 0.0;
+        bps = 0.0;
+        if (leg_.empty())
+            return;
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Size> alive;
+        aliveFlows(includeSettlementDateFlows, settlementDate, true, alive);
+        // the last date is the NPV date, so that all discounts are
+        // retrieved together
+        Size n = alive.size();
+        std::vector<Date> dates(n+1);
+        for (Size j=0; j<n; ++j)
+            dates[j] = dates_[alive[j]];
+        dates[n] = npvDate;
+        std::vector<DiscountFactor> discounts(dates.size());
+        discountCurve.discounts(dates, &discounts[0]);
+
+        for (Size j=0; j<n; ++j) {
+            Size i = alive[j];
+            evaluate(i);
+            npv += amounts_[i] * discounts[j];
+            bps += nominals_[i] * accrualPeriods_[i] * discounts[j];
+        }
+        DiscountFactor d = discounts[n];
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+    Real CompiledLeg::npv(const InterestRate& y,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Real> amounts;
+        std::vector<Time> periods;
+        yieldPeriods(y.dayCounter(), includeSettlementDateFlows,
+                     settlementDate, npvDate, amounts, periods);
+
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size j=0; j<amounts.size(); ++j) {
+            discount *= y.discountFactor(periods[j]);
+            npv += amounts[j] * discount;
+        }
+        return npv;
+    }
+
+    Time CompiledLeg::duration(const InterestRate& y,
+                               Duration::Type type,
+                               bool includeSettlementDateFlows,
+                               Date settlementDate,
+                               Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        if (type == Duration::Macaulay) {
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+        }
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Real> amounts;
+        std::vector<Time> periods;
+        yieldPeriods(y.dayCounter(), includeSettlementDateFlows,
+                     settlementDate, npvDate, amounts, periods);
+
+        Real P = 0.0;
+        Real dPdy = 0.0;
+        Time t = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size j=0; j<amounts.size(); ++j) {
+            Real c = amounts[j];
+            t += periods[j];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            if (type == Duration::Simple) {
+                dPdy += t * c * B;
+                continue;
+            }
+            switch (y.compounding()) {
+              case Simple:
+                dPdy -= c * B*B * t;
+                break;
+              case Compounded:
+                dPdy -= c * t * B/(1+r/N);
+                break;
+              case Continuous:
+                dPdy -= c * B * t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0) // no cashflows
+            return 0.0;
+
+        switch (type) {
+          case Duration::Simple:
+            return dPdy/P;
+          case Duration::Modified:
+            return -dPdy/P; // reverse derivative sign
+          case Duration::Macaulay:
+            return (1.0+r/N) * (-dPdy/P);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+    Real CompiledLeg::convexity(const InterestRate& y,
+                                bool includeSettlementDateFlows,
+                                Date settlementDate,
+                                Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Real> amounts;
+        std::vector<Time> periods;
+        yieldPeriods(y.dayCounter(), includeSettlementDateFlows,
+                     settlementDate, npvDate, amounts, periods);
+
+        Real P = 0.0;
+        Time t = 0.0;
+        Real d2Pdy2 = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size j=0; j<amounts.size(); ++j) {
+            Real c = amounts[j];
+            t += periods[j];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                d2Pdy2 += c * 2.0*B*B*B*t*t;
+                break;
+              case Compounded:
+                d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              case Continuous:
+                d2Pdy2 += c * B*t*t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                else
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                else
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0)
+            // no cashflows
+            return 0.0;
+
+        return d2Pdy2/P;
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          Spread zSpread,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Size> alive;
+        aliveFlows(includeSettlementDateFlows, settlementDate, true, alive);
+        Size n = alive.size();
+        std::vector<Real> amounts(n);
+        std::vector<Date> dates(n+1);
+        for (Size j=0; j<n; ++j) {
+            evaluate(alive[j]);
+            amounts[j] = amounts_[alive[j]];
+            dates[j] = dates_[alive[j]];
+        }
+        dates[n] = npvDate;
+        SpreadedDiscounts discounts(discountCurve, dates, dayCounter,
+                                    compounding, frequency);
+        return spreadedNpv(amounts, discounts, zSpread);
+    }
+
+    Spread CompiledLeg::zSpread(Real npv,
+                                const YieldTermStructure& discountCurve,
+                                const DayCounter& dayCounter,
+                                Compounding compounding,
+                                Frequency frequency,
+                                bool includeSettlementDateFlows,
+                                Date settlementDate,
+                                Date npvDate,
+                                Real accuracy,
+                                Size maxIterations,
+                                Rate guess) const {
+        QL_REQUIRE(!leg_.empty(), "empty leg");
+
+        calculate();
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<Size> alive;
+        aliveFlows(includeSettlementDateFlows, settlementDate, true, alive);
+        Size n = alive.size();
+        std::vector<Real> amounts(n);
+        std::vector<Date> dates(n+1);
+        for (Size j=0; j<n; ++j) {
+            evaluate(alive[j]);
+            amounts[j] = amounts_[alive[j]];
+            dates[j] = dates_[alive[j]];
+        }
+        dates[n] = npvDate;
+        // the original discount factors are retrieved only once
+        SpreadedDiscounts discounts(discountCurve, dates, dayCounter,
+                                    compounding, frequency);
+
+        Brent solver;
+        solver.setMaxEvaluations(maxIterations);
+        ZSpreadFinder objFunction(amounts, discounts, npv);
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
+}
@@ -0,0 +1,212 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2017 The QuantLib contributors
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief leg stored as contiguous arrays for fast analytics
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! Leg stored as contiguous arrays
+    /*! This class takes a snapshot of the payment dates, amounts,
+        nominals, accrual periods and rates of the cash flows in a
+        leg and stores them in separate arrays.  The analytics below
+        run over such arrays instead of calling the virtual methods
+        of each cash flow (and, for floating-rate coupons, their
+        pricers) and retrieve all the needed discount factors from
+        the curve in a single call.
+
+        The snapshot is taken lazily and retaken whenever one of the
+        cash flows notifies a change, e.g., when the forecast curve
+        of a floating-rate coupon is modified.  Amounts and rates are
+        only retrieved for the cash flows that the analytics below
+        need, i.e., those not yet paid at the settlement date; thus,
+        floating-rate coupons paid in the past don't need their
+        fixings unless the amounts() or rates() inspectors are
+        called.  Nominals, accrual periods and rates are set to zero
+        for cash flows which are not coupons.
+
+        The methods return the same results as the corresponding
+        ones in the CashFlows class and have the same semantics
+        regarding settlement and NPV dates.
+
+        \test the results are checked against those returned by the
+              CashFlows methods, also after the leg is modified.
+    */
+    class CompiledLeg : public LazyObject {
+      public:
+        explicit CompiledLeg(const Leg& leg);
+        //! \name Inspectors
+        //@{
+        const Leg& leg() const { return leg_; }
+        Size size() const { return leg_.size(); }
+        const std::vector<Date>& dates() const;
+        const std::vector<Real>& amounts() const;
+        const std::vector<Real>& nominals() const;
+        const std::vector<Time>& accrualPeriods() const;
+        const std::vector<Rate>& rates() const;
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        Real npv(const YieldTermStructure& discountCurve,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        Real bps(const YieldTermStructure& discountCurve,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        void npvbps(const YieldTermStructure& discountCurve,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate,
+                    Date npvDate,
+                    Real& npv,
+                    Real& bps) const;
+        //@}
+        //! \name Yield (a.k.a. Internal Rate of Return, i.e. IRR) functions
+        //@{
+        Real npv(const InterestRate& yield,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        Time duration(const InterestRate& yield,
+                      Duration::Type type,
+                      bool includeSettlementDateFlows,
+                      Date settlementDate = Date(),
+                      Date npvDate = Date()) const;
+        Real convexity(const InterestRate& yield,
+                       bool includeSettlementDateFlows,
+                       Date settlementDate = Date(),
+                       Date npvDate = Date()) const;
+        //@}
+        //! \name Z-spread functions
+        //@{
+        Real npv(const YieldTermStructure& discountCurve,
+                 Spread zSpread,
+                 const DayCounter& dayCounter,
+                 Compounding compounding,
+                 Frequency frequency,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        Spread zSpread(Real npv,
+                       const YieldTermStructure& discountCurve,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       bool includeSettlementDateFlows,
+                       Date settlementDate = Date(),
+                       Date npvDate = Date(),
+                       Real accuracy = 1.0e-10,
+                       Size maxIterations = 100,
+                       Rate guess = 0.0) const;
+        //@}
+      private:
+        //! \name LazyObject interface
+        //@{
+        void performCalculations() const;
+        //@}
+        // retrieves the amount and rate of the i-th cash flow
+        void evaluate(Size i) const;
+        void evaluateAll() const;
+        // indexes of the cash flows not yet paid at the settlement date
+        void aliveFlows(bool includeSettlementDateFlows,
+                        const Date& settlementDate,
+                        bool skipExCoupon,
+                        std::vector<Size>& indexes) const;
+        bool tradingExCoupon(Size i, const Date& settlementDate) const {
+            return exCouponDates_[i] != Date() &&
+                   exCouponDates_[i] <= settlementDate;
+        }
+        // amounts of the cash flows not yet paid at the settlement
+        // date and their year fractions from the previous ones
+        void yieldPeriods(const DayCounter& dayCounter,
+                          bool includeSettlementDateFlows,
+                          const Date& settlementDate,
+                          const Date& npvDate,
+                          std::vector<Real>& amounts,
+                          std::vector<Time>& periods) const;
+        Leg leg_;
+        mutable std::vector<Date> dates_, exCouponDates_;
+        mutable std::vector<Date> refPeriodStarts_, refPeriodEnds_;
+        mutable std::vector<Real> amounts_, nominals_;
+        mutable std::vector<Time> accrualPeriods_;
+        mutable std::vector<Rate> rates_;
+        mutable std::vector<bool> isCoupon_, evaluated_;
+    };
+
+
+    // inline definitions
+
+    inline void CompiledLeg::evaluate(Size i) const {
+        if (!evaluated_[i]) {
+            amounts_[i] = leg_[i]->amount();
+            if (isCoupon_[i])
+                rates_[i] =
+                    boost::static_pointer_cast<Coupon>(leg_[i])->rate();
+            evaluated_[i] = true;
+        }
+    }
+
+    inline void CompiledLeg::evaluateAll() const {
+        for (Size i=0; i<leg_.size(); ++i)
+            evaluate(i);
+    }
+
+    inline const std::vector<Date>& CompiledLeg::dates() const {
+        calculate();
+        return dates_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::amounts() const {
+        calculate();
+        evaluateAll();
+        return amounts_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::nominals() const {
+        calculate();
+        return nominals_;
+    }
+
+    inline const std::vector<Time>& CompiledLeg::accrualPeriods() const {
+        calculate();
+        return accrualPeriods_;
+    }
+
+    inline const std::vector<Rate>& CompiledLeg::rates() const {
+        calculate();
+        evaluateAll();
+        return rates_;
+    }
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/vectors.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 
 using std::vector;
 using boost::shared_ptr;
@@ -44,25 +45,22 @@ namespace QuantLib {
                     dynamic_pointer_cast<OvernightIndex>(coupon_->index());
 
                 const vector<Date>& fixingDates = coupon_->fixingDates();
+                const vector<Date>& dates = coupon_->valueDates();
                 const vector<Time>& dt = coupon_->dt();
 
-                Size n = dt.size(),
-                     i = 0;
+                Size n = dt.size();
 
                 Real compoundFactor = 1.0;
 
-                // already fixed part
+                // already fixed part; rates must have been fixed, and
+                // their compounded value is stored by the index
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[i]);
-                    compoundFactor *= (1.0 + pastFixing*dt[i]);
-                    ++i;
-                }
+                Size i = std::lower_bound(fixingDates.begin(),
+                                          fixingDates.end(),
+                                          today) - fixingDates.begin();
+                if (i>0)
+                    compoundFactor = index->compoundFactor(dates[0],
+                                                           dates[i]);
 
                 // today is a border case
                 if (i<n && fixingDates[i] == today) {
@@ -90,7 +88,6 @@ namespace QuantLib {
                                "null term structure set to this instance of "<<
                                index->name());
 
-                    const vector<Date>& dates = coupon_->valueDates();
                     DiscountFactor startDiscount = curve->discount(dates[i]);
                     DiscountFactor endDiscount = curve->discount(dates[n]);
 
@@ -23,6 +23,7 @@
 #include <ql/experimental/math/piecewisefunction.hpp>
 #include <ql/experimental/math/piecewiseintegral.hpp>
 #include <ql/experimental/math/polarstudenttrng.hpp>
+#include <ql/experimental/math/sparsegridquadrature.hpp>
 #include <ql/experimental/math/tcopulapolicy.hpp>
 #include <ql/experimental/math/zigguratrng.hpp>
 
@@ -31,13 +31,14 @@ namespace QuantLib {
         boost::shared_ptr<Intensity> intensity,
         boost::shared_ptr<RandomWalk> randomWalk,
         Size Mde, Real mutation,
-        Real crossover, unsigned long seed):
+        Real crossover, unsigned long seed,
+        bool parallelEvaluation):
         mutation_(mutation), crossover_(crossover),
         M_(M), Mde_(Mde), Mfa_(M_-Mde_), 
         intensity_(intensity),
         randomWalk_(randomWalk),
         drawIndex_(base_generator_type(seed), uniform_integer(Mfa_, Mde > 0 ? M_-1 : M_)),
-        rng_(seed){
+        rng_(seed), parallelEvaluation_(parallelEvaluation) {
         QL_REQUIRE(M_ >= Mde_,
             "Differential Evolution subpopulation cannot be larger than total population");
     }
@@ -66,9 +67,11 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.push_back(std::make_pair(P.value(x), i));
         }
+        //Evaluate points
+        Array values = P.value(x_, parallelEvaluation_);
+        for (Size i = 0; i < M_; i++)
+            values_.push_back(std::make_pair(values[i], i));
 
         //init intensity & randomWalk
         intensity_->init(this);
@@ -176,11 +179,13 @@ namespace QuantLib {
                 randomWalk_->walk();
 
                 //Loop over particles
+                std::vector<Array> zFA(Mfa_, Array(N_));
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& z = zFA[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
@@ -194,16 +199,22 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
+                }
+
+                //Evaluate particles; they are independent of each other
+                Array valFA = P.value(zFA, parallelEvaluation_);
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Real val = valFA[i];
                     if(!boost::math::isnan(val))
 					{
 						//Accept new point
-                        x = z;
+                        x_[index] = zFA[i];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
                             bestValue = val;
-                            bestX = x;
+                            bestX = x_[index];
                             iterationStat = 0;
                         }
 					}
@@ -81,6 +81,11 @@ namespace QuantLib {
                     if R_{i,j} > CR X_{i,j}^{k+1}
     Where CR is the crossover constant, and R is a random uniformly distributed
     number
+
+    If parallelEvaluation is true and the library was compiled with OpenMP, the
+    fireflies of each iteration are evaluated concurrently; the cost function must
+    then be safe to call from several threads. The DE subpopulation is still
+    evaluated sequentially, since each of its updates uses the ones accepted before.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
@@ -92,7 +97,8 @@ namespace QuantLib {
             boost::shared_ptr<Intensity> intensity,
             boost::shared_ptr<RandomWalk> randomWalk,
             Size Mde = 0, Real mutationFactor = 1.0,
-            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get());
+            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get(),
+            bool parallelEvaluation = false);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -106,6 +112,7 @@ namespace QuantLib {
         boost::shared_ptr<RandomWalk> randomWalk_;
         variate_integer drawIndex_;
         MersenneTwisterUniformRng rng_;
+        bool parallelEvaluation_;
     };
 
     //! Base intensity class
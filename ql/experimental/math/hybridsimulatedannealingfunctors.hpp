@@ -420,6 +420,10 @@ namespace QuantLib
     sensitive dimensions, therefore a reannealing schedule might raise the
     temperature seen by those more fruitful dimensions so as to allow for more
     movement along the dimensions of interest
+
+    If parallelEvaluation is true and the library was compiled with OpenMP, the
+    cost function is evaluated concurrently at the shifted points; it must then be
+    safe to call from several threads.
     */
     class ReannealingFiniteDifferences {
     public:
@@ -429,11 +433,12 @@ namespace QuantLib
             const Array & upper = Array(),
             Real stepSize = 1e-7,
             Real minSize = 1e-10,
-            Real functionTol = 1e-10)
+            Real functionTol = 1e-10,
+            bool parallelEvaluation = false)
             : stepSize_(stepSize), minSize_(minSize),
             functionTol_(functionTol), N_(dimension), bound_(false),
             lower_(lower), upper_(upper), initialTemp_(dimension, initialTemp),
-            bounded_(dimension, 1.0) {
+            bounded_(dimension, 1.0), parallelEvaluation_(parallelEvaluation) {
             if (lower.size() > 0 && upper.size() > 0) {
                 QL_REQUIRE(lower.size() == N_, "Incompatible input");
                 QL_REQUIRE(upper.size() == N_, "Incompatible input");
@@ -451,11 +456,13 @@ namespace QuantLib
 
             Array finiteDiffs(N_, 0.0);
             double finiteDiffMax = 0.0;
-            Array ofssetPoint(currentPoint);
+            std::vector<Array> offsetPoints(N_, currentPoint);
+            for (Size i = 0; i < N_; i++)
+                offsetPoints[i][i] += stepSize_;
+            Array offsetValues =
+                problem_->value(offsetPoints, parallelEvaluation_);
             for (Size i = 0; i < N_; i++) {
-                ofssetPoint[i] += stepSize_;
-                finiteDiffs[i] = bounded_[i] * std::abs((problem_->value(ofssetPoint) - currentValue) / stepSize_);
-                ofssetPoint[i] -= stepSize_;
+                finiteDiffs[i] = bounded_[i] * std::abs((offsetValues[i] - currentValue) / stepSize_);
                 if (finiteDiffs[i] < minSize_)
                     finiteDiffs[i] = minSize_;
                 if (finiteDiffs[i] > finiteDiffMax)
@@ -478,6 +485,7 @@ namespace QuantLib
         Size N_;
         bool bound_;
         Array lower_, upper_, initialTemp_, bounded_;
+        bool parallelEvaluation_;
     };
 }
 #endif // HYBRIDSIMULATEDANNEALINGFUNCTORS_H
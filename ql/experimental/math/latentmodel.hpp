@@ -23,6 +23,7 @@
 
 #include <ql/experimental/math/multidimquadrature.hpp>
 #include <ql/experimental/math/multidimintegrator.hpp>
+#include <ql/experimental/math/sparsegridquadrature.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 // for template spezs
@@ -110,7 +111,8 @@ namespace QuantLib {
             #ifndef QL_PATCH_SOLARIS
             GaussianQuadrature,
             #endif
-            Trapezoid
+            Trapezoid,
+            SparseGridQuadrature
             // etc....
         } LatentModelIntegrationType;
     }
@@ -140,6 +142,23 @@ namespace QuantLib {
 
     #endif
 
+    template<> class IntegrationBase<SparseGridGaussHermiteIntegrator> :
+    public SparseGridGaussHermiteIntegrator, public LMIntegration {
+    public:
+        IntegrationBase(Size dimension, Size level)
+        : SparseGridGaussHermiteIntegrator(dimension, level) {}
+        Real integrate(const boost::function<Real (
+            const std::vector<Real>& arg)>& f) const {
+                return SparseGridGaussHermiteIntegrator::integrate(f);
+        }
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> >  (
+                const std::vector<Real>& arg)>& f) const {
+                return SparseGridGaussHermiteIntegrator::integrateV(f);
+        }
+        virtual ~IntegrationBase() {}
+    };
+
     template<> class IntegrationBase<MultidimIntegral> : 
         public MultidimIntegral, public LMIntegration {
     public:
@@ -498,6 +517,15 @@ namespace QuantLib {
                           boost::make_shared<IntegrationBase<MultidimIntegral> >
                                (integrals, -35., 35.);
                         }
+                    case LatentModelIntegrationType::SparseGridQuadrature:
+                        /* Meant for models with several factors, for
+                        which the 25 points tensor product above becomes
+                        too expensive; one-factor models are better
+                        served by the plain quadrature. */
+                        return
+                            boost::make_shared<IntegrationBase<
+                                SparseGridGaussHermiteIntegrator> >(
+                                    dimension, 9);
                     default:
                         QL_FAIL("Unknown latent model integration type.");
                 }
@@ -60,22 +60,20 @@ namespace QuantLib {
             VectorIntegrator(Size n, Real mu = 0.0) 
             : GaussHermiteIntegration(n, mu) {}
 
-            template <class F> // todo: fix copies.
+            template <class F>
             detail::DispArray operator()(const F& f) const {
-                //first one, we do not know the size of the vector returned by f
+                // the vectors returned by f are moved into the sum or
+                // bound to a reference; they are never copied
                 Integer i = order()-1;
-                std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
-                std::for_each(term.begin(), term.end(), 
-                    std::bind1st(std::multiplies<Real>(), w_[i]));
-                std::vector<Real> sum = term;
-           
+                std::vector<Real> sum;
+                f(x_[i]).swap(sum);
+                for (Size j=0; j<sum.size(); ++j)
+                    sum[j] *= w_[i];
+
                 for (i--; i >= 0; --i) {
-                    term = f(x_[i]);// potential copy! @#$%^!!!
-                    // sum[j] += term[j] * w_[i];
-                    std::transform(term.begin(), term.end(), sum.begin(), 
-                        sum.begin(), 
-                        boost::bind(std::plus<Real>(), _2,
-                            boost::bind(std::multiplies<Real>(), w_[i], _1)));
+                    const std::vector<Real>& term = f(x_[i]);
+                    for (Size j=0; j<sum.size(); ++j)
+                        sum[j] += w_[i] * term[j];
                 }
                 return sum;
             }
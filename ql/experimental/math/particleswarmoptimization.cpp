@@ -32,10 +32,12 @@ namespace QuantLib {
         boost::shared_ptr<Topology> topology,
         boost::shared_ptr<Inertia> inertia,
         Real c1, Real c2,
-        unsigned long seed)
+        unsigned long seed,
+        bool parallelEvaluation)
         : M_(M), rng_(seed),
         topology_(topology),
-        inertia_(inertia) {
+        inertia_(inertia),
+        parallelEvaluation_(parallelEvaluation) {
         Real phi = c1 + c2;
         QL_ENSURE(phi*phi - 4 * phi, "Invalid phi");
         c0_ = 2.0 / std::abs(2.0 - phi - sqrt(phi*phi - 4 * phi));
@@ -47,9 +49,11 @@ namespace QuantLib {
         boost::shared_ptr<Topology> topology,
         boost::shared_ptr<Inertia> inertia,
         Real omega, Real c1, Real c2,
-        unsigned long seed)
+        unsigned long seed,
+        bool parallelEvaluation)
         : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed),
-        topology_(topology), inertia_(inertia) {}
+        topology_(topology), inertia_(inertia),
+        parallelEvaluation_(parallelEvaluation) {}
 
     void ParticleSwarmOptimization::startState(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(topology_, "Invalid topology");
@@ -84,10 +88,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        pBF_ = P.value(X_, parallelEvaluation_);
 
         //init topology & inertia
         topology_->init(this);
@@ -132,7 +137,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -152,15 +157,18 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
-                if (f < pBF_[i]) {
+            }
+
+            //Evaluate particles; they are independent of each other
+            Array f = P.value(X_, parallelEvaluation_);
+            for (Size i = 0; i < M_; i++) {
+                if (f[i] < pBF_[i]) {
                     //Update personal best
-                    pBF_[i] = f;
-                    pB = x;
+                    pBF_[i] = f[i];
+                    pBX_[i] = X_[i];
                     //Check stationary condition
-                    if (f < bestValue) {
-                        bestValue = f;
+                    if (f[i] < bestValue) {
+                        bestValue = f[i];
                         bestPosition = i;
                         iterationStat = 0;
                     }
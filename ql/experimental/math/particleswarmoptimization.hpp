@@ -87,6 +87,11 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    If parallelEvaluation is true and the library was compiled with OpenMP, the
+    particles of each iteration are evaluated concurrently; the cost function must
+    then be safe to call from several threads. Random numbers are still drawn
+    sequentially, so the results don't depend on the number of threads.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -98,12 +103,14 @@ namespace QuantLib {
             boost::shared_ptr<Topology> topology,
             boost::shared_ptr<Inertia> inertia,
             Real c1 = 2.05, Real c2 = 2.05,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            bool parallelEvaluation = false);
         explicit ParticleSwarmOptimization(const Size M,
             boost::shared_ptr<Topology> topology,
             boost::shared_ptr<Inertia> inertia,
             Real omega, Real c1, Real c2,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            bool parallelEvaluation = false);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -116,6 +123,7 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
         boost::shared_ptr<Topology> topology_;
         boost::shared_ptr<Inertia> inertia_;
+        bool parallelEvaluation_;
     };
 
     //! Base inertia class used to alter the PSO state
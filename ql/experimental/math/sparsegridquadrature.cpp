@@ -0,0 +1,213 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/sparsegridquadrature.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::map<std::vector<Real>, Real> Grid;
+
+        // Builds the grid by the combination technique, adding the
+        // tensor products of the one-dimensional rules for each
+        // admissible multi-index of levels.
+        class SmolyakGridBuilder {
+          public:
+            SmolyakGridBuilder(Size dimension, Size level, Real mu)
+            : dimension_(dimension), q_(level+dimension-1),
+              levels_(dimension), x_(level), w_(level) {
+                for (Size l=1; l<=level; ++l) {
+                    GaussHermiteIntegration rule(l, mu);
+                    x_[l-1] = std::vector<Real>(rule.x().begin(),
+                                                rule.x().end());
+                    w_[l-1] = std::vector<Real>(rule.weights().begin(),
+                                                rule.weights().end());
+                    // the central node of odd rules is zero up to
+                    // round-off; it must be the same for all of them
+                    // in order to be merged
+                    for (Size i=0; i<x_[l-1].size(); ++i)
+                        if (std::fabs(x_[l-1][i]) < 10*QL_EPSILON)
+                            x_[l-1][i] = 0.0;
+                }
+            }
+            void build(Grid& grid) {
+                addLevels(0, 0, grid);
+            }
+          private:
+            // chooses the level for dimension k given the sum of
+            // the levels already chosen
+            void addLevels(Size k, Size sum, Grid& grid) {
+                if (k == dimension_) {
+                    // sum is between q-d+1 and q
+                    Size j = q_ - sum;
+                    Real coefficient = binomial(dimension_-1, j);
+                    if (j % 2 == 1)
+                        coefficient = -coefficient;
+                    addTensorProduct(coefficient, grid);
+                    return;
+                }
+                // the remaining dimensions take between level 1 and
+                // the maximum level each
+                Size remaining = dimension_ - k - 1, L = x_.size();
+                Size minLevel = 1;
+                if (L > sum + remaining*L + 1)
+                    minLevel = L - sum - remaining*L;
+                Size maxLevel = std::min(L, q_ - sum - remaining);
+                for (Size l=minLevel; l<=maxLevel; ++l) {
+                    levels_[k] = l;
+                    addLevels(k+1, sum+l, grid);
+                }
+            }
+            void addTensorProduct(Real coefficient, Grid& grid) {
+                std::vector<Size> i(dimension_, 0);
+                std::vector<Real> node(dimension_);
+                for (;;) {
+                    Real weight = coefficient;
+                    for (Size k=0; k<dimension_; ++k) {
+                        node[k] = x_[levels_[k]-1][i[k]];
+                        weight *= w_[levels_[k]-1][i[k]];
+                    }
+                    grid[node] += weight;
+                    // next node of the product
+                    Size k = 0;
+                    while (k < dimension_ &&
+                           ++i[k] == x_[levels_[k]-1].size()) {
+                        i[k] = 0;
+                        ++k;
+                    }
+                    if (k == dimension_)
+                        break;
+                }
+            }
+            static Real binomial(Size n, Size k) {
+                Real result = 1.0;
+                for (Size i=1; i<=k; ++i)
+                    result = result*(n-k+i)/i;
+                return result;
+            }
+            Size dimension_, q_;
+            std::vector<Size> levels_;
+            std::vector<std::vector<Real> > x_, w_;
+        };
+
+    }
+
+    SparseGridGaussHermiteIntegrator::SparseGridGaussHermiteIntegrator(
+                     Size dimension, Size level, Real mu,
+                     bool parallelEvaluation)
+    : dimension_(dimension), level_(level),
+      parallelEvaluation_(parallelEvaluation) {
+        QL_REQUIRE(dimension_ > 0, "null dimension");
+        QL_REQUIRE(level_ > 0, "null level");
+
+        Grid grid;
+        SmolyakGridBuilder(dimension_, level_, mu).build(grid);
+
+        x_.reserve(grid.size());
+        w_.reserve(grid.size());
+        for (Grid::const_iterator i=grid.begin(); i!=grid.end(); ++i) {
+            // nodes whose weights cancel out are not evaluated
+            if (i->second != 0.0) {
+                x_.push_back(i->first);
+                w_.push_back(i->second);
+            }
+        }
+    }
+
+    Real SparseGridGaussHermiteIntegrator::integrate(
+            const boost::function<Real (const std::vector<Real>&)>& f) const {
+        Real sum = 0.0;
+#ifdef _OPENMP
+        if (parallelEvaluation_) {
+            // exceptions can't leave the parallel region; they're
+            // collected and the first one is raised afterwards
+            std::vector<Real> values(x_.size());
+            std::vector<std::string> errors(x_.size());
+            std::vector<int> failed(x_.size(), 0);
+#pragma omp parallel for default(shared)
+            for (long i=0; i<static_cast<long>(x_.size()); ++i) {
+                try {
+                    values[i] = f(x_[i]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                    failed[i] = 1;
+                }
+            }
+            for (Size i=0; i<x_.size(); ++i) {
+                QL_REQUIRE(!failed[i], errors[i]);
+                sum += w_[i] * values[i];
+            }
+            return sum;
+        }
+#endif
+        for (Size i=0; i<x_.size(); ++i)
+            sum += w_[i] * f(x_[i]);
+        return sum;
+    }
+
+    Disposable<std::vector<Real> >
+    SparseGridGaussHermiteIntegrator::integrateV(
+            const boost::function<Disposable<std::vector<Real> > (
+                                   const std::vector<Real>&)>& f) const {
+        std::vector<Real> sum;
+#ifdef _OPENMP
+        if (parallelEvaluation_) {
+            std::vector<std::vector<Real> > values(x_.size());
+            std::vector<std::string> errors(x_.size());
+            std::vector<int> failed(x_.size(), 0);
+#pragma omp parallel for default(shared)
+            for (long i=0; i<static_cast<long>(x_.size()); ++i) {
+                try {
+                    f(x_[i]).swap(values[i]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                    failed[i] = 1;
+                }
+            }
+            for (Size i=0; i<x_.size(); ++i)
+                QL_REQUIRE(!failed[i], errors[i]);
+            sum.resize(values[0].size(), 0.0);
+            for (Size i=0; i<x_.size(); ++i) {
+                QL_REQUIRE(values[i].size() == sum.size(),
+                           "integrand size mismatch");
+                for (Size j=0; j<sum.size(); ++j)
+                    sum[j] += w_[i] * values[i][j];
+            }
+            return sum;
+        }
+#endif
+        for (Size i=0; i<x_.size(); ++i) {
+            // bound to the temporary, so that no copy is made
+            const std::vector<Real>& term = f(x_[i]);
+            if (i == 0)
+                sum.resize(term.size(), 0.0);
+            QL_REQUIRE(term.size() == sum.size(),
+                       "integrand size mismatch");
+            for (Size j=0; j<sum.size(); ++j)
+                sum[j] += w_[i] * term[j];
+        }
+        return sum;
+    }
+
+}
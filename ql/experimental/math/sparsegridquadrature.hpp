@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sparsegridquadrature.hpp
+    \brief Smolyak sparse-grid Gauss-Hermite cubature
+*/
+
+#ifndef quantlib_math_sparse_grid_quadrature_hpp
+#define quantlib_math_sparse_grid_quadrature_hpp
+
+#include <ql/utilities/disposable.hpp>
+#include <ql/types.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Sparse-grid Gauss-Hermite integration over \f$ R^{dim} \f$
+    /*! The integral of a scalar or vector function over
+        \f$ R^{dim} \f$ is approximated by the Smolyak combination of
+        the tensor products of one-dimensional Gauss-Hermite rules,
+        \f[
+        A(q,d) = \sum_{q-d+1 \leq |l| \leq q} (-1)^{q-|l|}
+                 \binom{d-1}{q-|l|}
+                 U^{l_1} \otimes \dots \otimes U^{l_d},
+        \f]
+        where \f$ q = level + d - 1 \f$ and \f$ U^l \f$ is the
+        Gauss-Hermite rule of order \f$ l \f$ (F. Heiss and V. Winschel,
+        "Likelihood approximation by numerical integration on sparse
+        grids", Journal of Econometrics 144, 2008).  Nodes shared by
+        different products are merged, so that the integrand is
+        evaluated once per node.
+
+        A grid of level \f$ l \f$ is exact for polynomials (times the
+        Gauss-Hermite weight) of total degree up to \f$ 2l-1 \f$, as
+        the full tensor product of order \f$ l \f$ rules used by
+        GaussianQuadMultidimIntegrator; however, the number of its
+        nodes grows much more slowly with the dimension.  For
+        instance, at level 5 it uses 385 nodes instead of 625 in four
+        dimensions and 8761 instead of 9765625 in ten.  In one or two
+        dimensions, the tensor product is usually the better choice.
+
+        Nodes and weights are calculated once at construction.  As
+        for GaussianQuadMultidimIntegrator, the weight function is
+        divided out of the weights, i.e., the integrand is the whole
+        function to be integrated.
+
+        If parallel evaluation is requested and the library was
+        compiled with OpenMP, the integrand is evaluated concurrently
+        at the nodes and must therefore be safe to call from several
+        threads.  The values are summed in the same order in both
+        cases, so that the result doesn't depend on the number of
+        threads.
+
+        \test the results are checked against known integrals and
+              against those of the full tensor-product quadrature;
+              the parallel evaluation is checked against the serial
+              one.
+    */
+    class SparseGridGaussHermiteIntegrator {
+      public:
+        /*!
+            @param dimension The number of dimensions of the argument of the
+            function we want to integrate.
+            @param level Level of the sparse grid; level 1 uses the origin
+            only.
+            @param mu Parameter in the Gauss Hermite weight.
+            @param parallelEvaluation Whether the integrand is to be
+            evaluated concurrently at the nodes.
+        */
+        SparseGridGaussHermiteIntegrator(Size dimension,
+                                         Size level,
+                                         Real mu = 0.0,
+                                         bool parallelEvaluation = false);
+        //! \name Inspectors
+        //@{
+        Size dimension() const { return dimension_; }
+        Size level() const { return level_; }
+        //! number of distinct nodes of the grid
+        Size size() const { return x_.size(); }
+        const std::vector<std::vector<Real> >& nodes() const { return x_; }
+        const std::vector<Real>& weights() const { return w_; }
+        bool parallelEvaluation() const { return parallelEvaluation_; }
+        //@}
+        //! Integrates a scalar function over \f$ R^{dim} \f$
+        Real integrate(
+            const boost::function<Real (const std::vector<Real>&)>& f) const;
+        Real operator()(
+            const boost::function<Real (const std::vector<Real>&)>& f) const {
+            return integrate(f);
+        }
+        //! Integrates a vector function over \f$ R^{dim} \f$
+        /*! The values returned by the integrand are accumulated in
+            place; the integrand must return vectors of the same size
+            at all nodes.
+        */
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> > (
+                                         const std::vector<Real>&)>& f) const;
+      private:
+        Size dimension_, level_;
+        bool parallelEvaluation_;
+        // each node is stored separately so that it can be passed
+        // to the integrand without copies, also from several threads
+        std::vector<std::vector<Real> > x_;
+        std::vector<Real> w_;
+    };
+
+}
+
+#endif
@@ -48,6 +48,7 @@ namespace QuantLib {
                         bool registerAsObserver);
             bool empty() const { return !h_; }
             const boost::shared_ptr<T>& currentLink() const { return h_; }
+            bool isObserver() const { return isObserver_; }
             void update() { notifyObservers(); }
           private:
             boost::shared_ptr<T> h_;
@@ -82,6 +83,8 @@ namespace QuantLib {
         const boost::shared_ptr<T>& operator*() const;
         //! checks if the contained shared pointer points to anything
         bool empty() const;
+        //! checks if the notifications of the pointee are forwarded
+        bool isObserver() const;
         //! allows registration as observable
         operator boost::shared_ptr<Observable>() const;
         //! equality test
@@ -166,6 +169,11 @@ namespace QuantLib {
         return link_->empty();
     }
 
+    template <class T>
+    inline bool Handle<T>::isObserver() const {
+        return link_->isObserver();
+    }
+
     template <class T>
     inline Handle<T>::operator boost::shared_ptr<Observable>() const {
         return link_;
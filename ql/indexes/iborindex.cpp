@@ -21,6 +21,7 @@
 
 #include <ql/indexes/iborindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -35,7 +36,8 @@ namespace QuantLib {
                          const Handle<YieldTermStructure>& h)
     : InterestRateIndex(familyName, tenor, settlementDays, currency,
                         fixingCalendar, dayCounter),
-      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth) {
+      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth),
+      forecastCurve_(0) {
         registerWith(termStructure_);
       }
 
@@ -80,7 +82,11 @@ namespace QuantLib {
                                    const DayCounter& dc,
                                    const Handle<YieldTermStructure>& h)
    : IborIndex(familyName, 1*Days, settlementDays, curr,
-               fixCal, Following, false, dc, h) {}
+               fixCal, Following, false, dc, h),
+     compoundingCache_(new CompoundingCache) {
+        compoundingCache_->registerWith(
+                                 IndexManager::instance().notifier(name()));
+    }
 
     boost::shared_ptr<IborIndex> OvernightIndex::clone(
                                const Handle<YieldTermStructure>& h) const {
@@ -93,4 +99,78 @@ namespace QuantLib {
                                                            h));
     }
 
+    Real OvernightIndex::compoundFactor(const Date& startValueDate,
+                                        const Date& endValueDate) const {
+        QL_REQUIRE(startValueDate <= endValueDate,
+                   "start value date (" << startValueDate
+                   << ") later than end value date ("
+                   << endValueDate << ")");
+        if (startValueDate == endValueDate)
+            return 1.0;
+
+        compounding_map& ranges = compoundingCache_->ranges;
+
+        // look for a stored range containing the start date...
+        compounding_map::iterator r = ranges.upper_bound(startValueDate);
+        if (r != ranges.begin())
+            --r;
+        if (r == ranges.end() || r->first > startValueDate ||
+            r->second.dates.back() < startValueDate) {
+            // ...or start a new one
+            CompoundingRange range;
+            range.dates.push_back(startValueDate);
+            range.factors.push_back(1.0);
+            r = ranges.insert(std::make_pair(startValueDate, range)).first;
+        }
+
+        std::vector<Date>& dates = r->second.dates;
+        std::vector<Real>& factors = r->second.factors;
+
+        // extend the range up to the end date if needed; the following
+        // range is appended when it's reached, so the fixings between
+        // requested ranges are never used
+        if (dates.back() < endValueDate) {
+            const TimeSeries<Real>& history =
+                IndexManager::instance().getHistory(name());
+            compounding_map::iterator next = r;
+            ++next;
+            Date d = dates.back();
+            while (d < endValueDate) {
+                if (next != ranges.end() && next->first == d) {
+                    const CompoundingRange& following = next->second;
+                    Real factor = factors.back();
+                    dates.insert(dates.end(), following.dates.begin()+1,
+                                 following.dates.end());
+                    for (Size k=1; k<following.factors.size(); ++k)
+                        factors.push_back(factor * following.factors[k]);
+                    ranges.erase(next++);
+                    d = dates.back();
+                    continue;
+                }
+                Date nextDate = fixingCalendar().advance(d, 1, Days);
+                Date fixingDate = this->fixingDate(d);
+                Rate pastFixing = history[fixingDate];
+                QL_REQUIRE(pastFixing != Null<Real>(),
+                           "Missing " << name() <<
+                           " fixing for " << fixingDate);
+                factors.push_back(factors.back() *
+                    (1.0 + pastFixing*dayCounter().yearFraction(d, nextDate)));
+                dates.push_back(nextDate);
+                d = nextDate;
+            }
+        }
+
+        std::vector<Date>::iterator i =
+            std::lower_bound(dates.begin(), dates.end(), startValueDate);
+        std::vector<Date>::iterator j =
+            std::lower_bound(i, dates.end(), endValueDate);
+        QL_REQUIRE(*i == startValueDate,
+                   startValueDate << " is not a valid value date for "
+                   << name());
+        QL_REQUIRE(j != dates.end() && *j == endValueDate,
+                   endValueDate << " is not a valid value date for "
+                   << name());
+        return factors[j - dates.begin()] / factors[i - dates.begin()];
+    }
+
 }
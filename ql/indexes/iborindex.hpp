@@ -28,10 +28,27 @@
 
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <map>
 
 namespace QuantLib {
 
     //! base class for Inter-Bank-Offered-Rate indexes (e.g. %Libor, etc.)
+    /*! Forecast fixings are stored when first calculated, so that
+        coupons sharing the same index and fixing dates (e.g., in a
+        book of swaps) don't retrieve the same discount factors from
+        the forwarding curve.  The stored values are discarded when
+        the index is notified of a change, i.e., when the forwarding
+        curve changes or is relinked, when the evaluation date
+        changes, or when fixings are added; they are also discarded
+        when the handle is found linked to a different curve, and
+        when their number reaches maxForecastFixings.  They are not
+        stored when the handle to the curve doesn't forward its
+        notifications, as for the indexes used by bootstrap helpers.
+
+        \warning the stored values are not synchronized; the same
+                 index should not be used concurrently from
+                 different threads.
+    */
     class IborIndex : public InterestRateIndex {
       public:
         IborIndex(const std::string& familyName,
@@ -49,6 +66,10 @@ namespace QuantLib {
         Date maturityDate(const Date& valueDate) const;
         Rate forecastFixing(const Date& fixingDate) const;
         // @}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
         //! \name Inspectors
         //@{
         BusinessDayConvention businessDayConvention() const;
@@ -83,6 +104,11 @@ namespace QuantLib {
                             const Date& endDate,
                             Time t) const;
         friend class IborCoupon;
+        // stored forecasts, keyed by value and maturity date, and the
+        // curve they were retrieved from
+        static const Size maxForecastFixings = 1000;
+        mutable std::map<std::pair<Date,Date>, Rate> forecastFixings_;
+        mutable const YieldTermStructure* forecastCurve_;
     };
 
 
@@ -98,6 +124,41 @@ namespace QuantLib {
         //! returns a copy of itself linked to a different forwarding curve
         boost::shared_ptr<IborIndex> clone(
                                    const Handle<YieldTermStructure>& h) const;
+        /*! returns the product of the factors \f$ 1 + r_i \tau_i \f$
+            over the fixings for the value dates in the
+            [startValueDate, endValueDate) range, i.e., the
+            compounding factor of an overnight-indexed coupon over
+            that range.  All the fixings must be already stored.
+
+            The cumulative products of the factors over the fixing
+            calendar are stored for each contiguous range of
+            requested value dates, so that the result is retrieved in
+            logarithmic time after the first call; no fixings are
+            required between the ranges.  The stored products are
+            discarded when the fixings of the index change.
+
+            \warning the stored products are not synchronized; the
+                     same index should not be used concurrently
+                     from different threads.
+        */
+        Real compoundFactor(const Date& startValueDate,
+                            const Date& endValueDate) const;
+      private:
+        // cumulative products over ranges of value dates, keyed by
+        // the first date in each range
+        struct CompoundingRange {
+            std::vector<Date> dates;
+            std::vector<Real> factors;
+        };
+        typedef std::map<Date, CompoundingRange> compounding_map;
+        // the products only depend on past fixings, so the cache
+        // listens to the fixings alone and not to the forecast curve
+        class CompoundingCache : public Observer {
+          public:
+            compounding_map ranges;
+            void update() { ranges.clear(); }
+        };
+        boost::shared_ptr<CompoundingCache> compoundingCache_;
     };
 
 
@@ -117,9 +178,33 @@ namespace QuantLib {
                                           Time t) const {
         QL_REQUIRE(!termStructure_.empty(),
                    "null term structure set to this instance of " << name());
+        bool cached = termStructure_.isObserver();
+        if (cached) {
+            const YieldTermStructure* curve =
+                termStructure_.currentLink().get();
+            if (curve != forecastCurve_) {
+                forecastFixings_.clear();
+                forecastCurve_ = curve;
+            }
+            std::map<std::pair<Date,Date>, Rate>::const_iterator i =
+                forecastFixings_.find(std::make_pair(d1, d2));
+            if (i != forecastFixings_.end())
+                return i->second;
+        }
         DiscountFactor disc1 = termStructure_->discount(d1);
         DiscountFactor disc2 = termStructure_->discount(d2);
-        return (disc1/disc2 - 1.0) / t;
+        Rate fixing = (disc1/disc2 - 1.0) / t;
+        if (cached) {
+            if (forecastFixings_.size() >= maxForecastFixings)
+                forecastFixings_.clear();
+            forecastFixings_[std::make_pair(d1, d2)] = fixing;
+        }
+        return fixing;
+    }
+
+    inline void IborIndex::update() {
+        forecastFixings_.clear();
+        InterestRateIndex::update();
     }
 
 }
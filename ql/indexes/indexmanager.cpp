@@ -33,7 +33,9 @@ using std::string;
 namespace QuantLib {
 
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        // cleared histories are kept as empty series
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        return i != data_.end() && !i->second.value().empty();
     }
 
     const TimeSeries<Real>&
@@ -55,17 +57,22 @@ namespace QuantLib {
         std::vector<string> temp;
         temp.reserve(data_.size());
         for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+             i!=data_.end(); ++i) {
+            if (!i->second.value().empty())
+                temp.push_back(i->first);
+        }
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        // the stored value is reset rather than erased, so that the
+        // indexes registered with it are still notified of changes
+        data_[to_upper_copy(name)] = TimeSeries<Real>();
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        for (history_map::iterator i=data_.begin(); i!=data_.end(); ++i)
+            i->second = TimeSeries<Real>();
     }
 
 }
@@ -38,7 +38,7 @@ namespace QuantLib {
       private:
         IndexManager() {}
       public:
-        //! returns whether historical fixings were stored for the index
+        //! returns whether historical fixings are stored for the index
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
         const TimeSeries<Real>& getHistory(const std::string& name) const;
@@ -46,7 +46,7 @@ namespace QuantLib {
         void setHistory(const std::string& name, const TimeSeries<Real>&);
         //! observer notifying of changes in the index fixings
         boost::shared_ptr<Observable> notifier(const std::string& name) const;
-        //! returns all names of the indexes for which fixings were stored
+        //! returns all names of the indexes for which fixings are stored
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
         void clearHistory(const std::string& name);
@@ -56,7 +56,7 @@ namespace QuantLib {
       fixedFirstDate_(Date()), fixedNextToLastDate_(Date()),
       floatFirstDate_(Date()), floatNextToLastDate_(Date()),
       floatSpread_(0.0),
-      floatDayCount_(index->dayCounter()) {}
+      floatDayCount_(index->dayCounter()), cachedSchedules_(false) {}
 
     MakeVanillaSwap::operator VanillaSwap() const {
         shared_ptr<VanillaSwap> swap = *this;
@@ -117,19 +117,41 @@ namespace QuantLib {
                 QL_FAIL("unknown fixed leg default tenor for " << curr);
         }
 
-        Schedule fixedSchedule(startDate, endDate,
-                               fixedTenor, fixedCalendar_,
-                               fixedConvention_,
-                               fixedTerminationDateConvention_,
-                               fixedRule_, fixedEndOfMonth_,
-                               fixedFirstDate_, fixedNextToLastDate_);
-
-        Schedule floatSchedule(startDate, endDate,
-                               floatTenor_, floatCalendar_,
-                               floatConvention_,
-                               floatTerminationDateConvention_,
-                               floatRule_, floatEndOfMonth_,
-                               floatFirstDate_, floatNextToLastDate_);
+        // the schedules are shared with the swap, and possibly with
+        // other swaps if taken from the cache
+        shared_ptr<const Schedule> fixedSchedule, floatSchedule;
+        if (cachedSchedules_) {
+            ScheduleCache& cache = ScheduleCache::instance();
+            fixedSchedule = cache.schedule(startDate, endDate,
+                                           fixedTenor, fixedCalendar_,
+                                           fixedConvention_,
+                                           fixedTerminationDateConvention_,
+                                           fixedRule_, fixedEndOfMonth_,
+                                           fixedFirstDate_,
+                                           fixedNextToLastDate_);
+            floatSchedule = cache.schedule(startDate, endDate,
+                                           floatTenor_, floatCalendar_,
+                                           floatConvention_,
+                                           floatTerminationDateConvention_,
+                                           floatRule_, floatEndOfMonth_,
+                                           floatFirstDate_,
+                                           floatNextToLastDate_);
+        } else {
+            fixedSchedule = shared_ptr<const Schedule>(new
+                Schedule(startDate, endDate,
+                         fixedTenor, fixedCalendar_,
+                         fixedConvention_,
+                         fixedTerminationDateConvention_,
+                         fixedRule_, fixedEndOfMonth_,
+                         fixedFirstDate_, fixedNextToLastDate_));
+            floatSchedule = shared_ptr<const Schedule>(new
+                Schedule(startDate, endDate,
+                         floatTenor_, floatCalendar_,
+                         floatConvention_,
+                         floatTerminationDateConvention_,
+                         floatRule_, floatEndOfMonth_,
+                         floatFirstDate_, floatNextToLastDate_));
+        }
 
         DayCounter fixedDayCount;
         if (fixedDayCount_ != DayCounter())
@@ -351,4 +373,9 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeVanillaSwap& MakeVanillaSwap::withCachedSchedules(bool flag) {
+        cachedSchedules_ = flag;
+        return *this;
+    }
+
 }
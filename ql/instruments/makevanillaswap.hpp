@@ -78,6 +78,9 @@ namespace QuantLib {
         MakeVanillaSwap& withFloatingLegDayCount(const DayCounter& dc);
         MakeVanillaSwap& withFloatingLegSpread(Spread sp);
 
+        //! take the leg schedules from the global ScheduleCache
+        MakeVanillaSwap& withCachedSchedules(bool flag = true);
+
         MakeVanillaSwap& withDiscountingTermStructure(
                               const Handle<YieldTermStructure>& discountCurve);
         MakeVanillaSwap& withPricingEngine(
@@ -103,6 +106,7 @@ namespace QuantLib {
         Date floatFirstDate_, floatNextToLastDate_;
         Spread floatSpread_;
         DayCounter fixedDayCount_, floatDayCount_;
+        bool cachedSchedules_;
 
         boost::shared_ptr<PricingEngine> engine_;
     };
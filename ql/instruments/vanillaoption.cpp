@@ -24,6 +24,7 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdbermudanengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/exercise.hpp>
 #include <boost/scoped_ptr.hpp>
 
@@ -35,6 +36,39 @@ namespace QuantLib {
     : OneAssetOption(payoff, exercise) {}
 
 
+    Volatility VanillaOption::europeanImpliedVolatility(
+                          const PlainVanillaPayoff& payoff,
+                          const GeneralizedBlackScholesProcess& process,
+                          Real targetValue,
+                          Real accuracy,
+                          Size maxEvaluations,
+                          Volatility minVol,
+                          Volatility maxVol) const {
+        // same inputs as in the AnalyticEuropeanEngine
+        Date maturity = exercise_->lastDate();
+        Time t = process.blackVolatility()->timeFromReference(maturity);
+        DiscountFactor dividendDiscount =
+            process.dividendYield()->discount(maturity);
+        DiscountFactor riskFreeDiscount =
+            process.riskFreeRate()->discount(maturity);
+        Real spot = process.stateVariable()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+        Real forward = spot * dividendDiscount / riskFreeDiscount;
+
+        Real stdDev = blackFormulaImpliedStdDev(payoff.optionType(),
+                                                payoff.strike(),
+                                                forward, targetValue,
+                                                riskFreeDiscount, 0.0,
+                                                Null<Real>(),
+                                                accuracy*std::sqrt(t),
+                                                maxEvaluations);
+        Volatility vol = stdDev/std::sqrt(t);
+        QL_REQUIRE(vol >= minVol && vol <= maxVol,
+                   "implied volatility (" << vol << ") outside the "
+                   "allowed range [" << minVol << ", " << maxVol << "]");
+        return vol;
+    }
+
     Volatility VanillaOption::impliedVolatility(
              Real targetValue,
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -45,6 +79,16 @@ namespace QuantLib {
 
         QL_REQUIRE(!isExpired(), "option expired");
 
+        // plain European options are inverted directly, without
+        // repricing the option through the engine at each iteration
+        boost::shared_ptr<PlainVanillaPayoff> plainPayoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoff_);
+        if (exercise_->type() == Exercise::European && plainPayoff)
+            return europeanImpliedVolatility(*plainPayoff, *process,
+                                             targetValue, accuracy,
+                                             maxEvaluations,
+                                             minVol, maxVol);
+
         boost::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
 
         boost::shared_ptr<GeneralizedBlackScholesProcess> newProcess =
@@ -64,6 +64,15 @@ namespace QuantLib {
              Size maxEvaluations = 100,
              Volatility minVol = 1.0e-7,
              Volatility maxVol = 4.0) const;
+      private:
+        Volatility europeanImpliedVolatility(
+                          const PlainVanillaPayoff& payoff,
+                          const GeneralizedBlackScholesProcess& process,
+                          Real targetValue,
+                          Real accuracy,
+                          Size maxEvaluations,
+                          Volatility minVol,
+                          Volatility maxVol) const;
     };
 
 }
@@ -41,23 +41,49 @@ namespace QuantLib {
                      Spread spread,
                      const DayCounter& floatingDayCount,
                      boost::optional<BusinessDayConvention> paymentConvention)
+    : Swap(2), type_(type), nominal_(nominal),
+      fixedSchedule_(new Schedule(fixedSchedule)), fixedRate_(fixedRate),
+      fixedDayCount_(fixedDayCount),
+      floatingSchedule_(new Schedule(floatSchedule)),
+      iborIndex_(iborIndex), spread_(spread),
+      floatingDayCount_(floatingDayCount) {
+        initialize(paymentConvention);
+    }
+
+    VanillaSwap::VanillaSwap(
+                     Type type,
+                     Real nominal,
+                     const boost::shared_ptr<const Schedule>& fixedSchedule,
+                     Rate fixedRate,
+                     const DayCounter& fixedDayCount,
+                     const boost::shared_ptr<const Schedule>& floatSchedule,
+                     const boost::shared_ptr<IborIndex>& iborIndex,
+                     Spread spread,
+                     const DayCounter& floatingDayCount,
+                     boost::optional<BusinessDayConvention> paymentConvention)
     : Swap(2), type_(type), nominal_(nominal),
       fixedSchedule_(fixedSchedule), fixedRate_(fixedRate),
       fixedDayCount_(fixedDayCount),
       floatingSchedule_(floatSchedule), iborIndex_(iborIndex), spread_(spread),
       floatingDayCount_(floatingDayCount) {
+        QL_REQUIRE(fixedSchedule_, "null fixed-leg schedule");
+        QL_REQUIRE(floatingSchedule_, "null floating-leg schedule");
+        initialize(paymentConvention);
+    }
 
+    void VanillaSwap::initialize(
+                  boost::optional<BusinessDayConvention> paymentConvention) {
         if (paymentConvention)
             paymentConvention_ = *paymentConvention;
         else
-            paymentConvention_ = floatingSchedule_.businessDayConvention();
+            paymentConvention_ = floatingSchedule_->businessDayConvention();
 
-        legs_[0] = FixedRateLeg(fixedSchedule_)
+        legs_[0] = FixedRateLeg(*fixedSchedule_)
             .withNotionals(nominal_)
             .withCouponRates(fixedRate_, fixedDayCount_)
             .withPaymentAdjustment(paymentConvention_);
 
-        legs_[1] = IborLeg(floatingSchedule_, iborIndex_)
+        legs_[1] = IborLeg(*floatingSchedule_, iborIndex_)
             .withNotionals(nominal_)
             .withPaymentDayCounter(floatingDayCount_)
             .withPaymentAdjustment(paymentConvention_)
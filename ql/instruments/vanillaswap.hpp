@@ -80,6 +80,22 @@ namespace QuantLib {
             const DayCounter& floatingDayCount,
             boost::optional<BusinessDayConvention> paymentConvention =
                                                                  boost::none);
+        /*! The schedules are shared instead of copied; this allows,
+            e.g., swaps built with schedules from the ScheduleCache
+            to use the same instances.
+        */
+        VanillaSwap(
+            Type type,
+            Real nominal,
+            const boost::shared_ptr<const Schedule>& fixedSchedule,
+            Rate fixedRate,
+            const DayCounter& fixedDayCount,
+            const boost::shared_ptr<const Schedule>& floatSchedule,
+            const boost::shared_ptr<IborIndex>& iborIndex,
+            Spread spread,
+            const DayCounter& floatingDayCount,
+            boost::optional<BusinessDayConvention> paymentConvention =
+                                                                 boost::none);
         //! \name Inspectors
         //@{
         Type type() const;
@@ -114,13 +130,14 @@ namespace QuantLib {
         void setupArguments(PricingEngine::arguments* args) const;
         void fetchResults(const PricingEngine::results*) const;
       private:
+        void initialize(boost::optional<BusinessDayConvention>);
         void setupExpired() const;
         Type type_;
         Real nominal_;
-        Schedule fixedSchedule_;
+        boost::shared_ptr<const Schedule> fixedSchedule_;
         Rate fixedRate_;
         DayCounter fixedDayCount_;
-        Schedule floatingSchedule_;
+        boost::shared_ptr<const Schedule> floatingSchedule_;
         boost::shared_ptr<IborIndex> iborIndex_;
         Spread spread_;
         DayCounter floatingDayCount_;
@@ -175,7 +192,7 @@ namespace QuantLib {
     }
 
     inline const Schedule& VanillaSwap::fixedSchedule() const {
-        return fixedSchedule_;
+        return *fixedSchedule_;
     }
 
     inline Rate VanillaSwap::fixedRate() const {
@@ -187,7 +204,7 @@ namespace QuantLib {
     }
 
     inline const Schedule& VanillaSwap::floatingSchedule() const {
-        return floatingSchedule_;
+        return *floatingSchedule_;
     }
 
     inline const boost::shared_ptr<IborIndex>& VanillaSwap::iborIndex() const {
@@ -30,6 +30,7 @@
 #include <ql/errors.hpp>
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
+#include <ql/utilities/alignedarray.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
 #include <boost/scoped_array.hpp>
 #include <boost/type_traits.hpp>
@@ -46,7 +47,20 @@ namespace QuantLib {
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
-        \test construction of arrays is checked in a number of cases
+        Arrays of up to four elements, such as the parameters of most
+        models, are stored within the object and don't allocate
+        memory; the elements of longer arrays are allocated on the
+        heap and aligned to a 64-byte boundary.  In both cases, the
+        elements are contiguous.
+
+        Algebraic operations whose operands are temporaries returned by
+        other operations reuse their storage, so that an expression
+        such as <tt>a*b + c*d</tt> allocates two arrays instead of three.
+
+        \test construction of arrays is checked in a number of cases;
+              operations on temporaries are checked against element-wise
+              calculations; copies and swaps are checked for both
+              inline and heap storage.
     */
     class Array {
       public:
@@ -135,8 +149,13 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        // arrays up to this size are stored inline
+        enum { inlineSize = 4 };
+        void allocate(Size size);
+        AlignedArray<Real> heap_;
+        Real* data_;
         Size n_;
+        Real buffer_[inlineSize];
     };
 
     //! specialization of null template for this class
@@ -184,6 +203,60 @@ namespace QuantLib {
     /*! \relates Array */
     const Disposable<Array> operator/(Real, const Array&);
 
+    /* The overloads below are selected when an operand is the
+       temporary returned by another operation, as in a*b + c*d; the
+       storage of the temporary is reused for the result, so that no
+       further allocation is needed.
+
+       Warning: in C++03 a temporary can't be told apart from a named
+       Disposable<Array>, so the latter is also emptied by the first
+       operation using it, as it would be by a copy.  Results to be
+       used more than once must be stored in an Array, which is never
+       modified by these operators.
+    */
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>& v);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator+(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator-(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator*(Real, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Array&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Disposable<Array>&, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator/(Real, const Disposable<Array>&);
+
     // math functions
     /*! \relates Array */
     const Disposable<Array> Abs(const Array&);
@@ -195,6 +268,16 @@ namespace QuantLib {
     const Disposable<Array> Exp(const Array&);
     /*! \relates Array */
     const Disposable<Array> Pow(const Array&, Real);
+    /*! \relates Array */
+    const Disposable<Array> Abs(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Sqrt(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Log(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Exp(const Disposable<Array>&);
+    /*! \relates Array */
+    const Disposable<Array> Pow(const Disposable<Array>&, Real);
 
     // utilities
     /*! \relates Array */
@@ -207,22 +290,38 @@ namespace QuantLib {
 
     // inline definitions
 
+    inline void Array::allocate(Size size) {
+        if (size > Size(inlineSize)) {
+            heap_.reset(size);
+            data_ = heap_.get();
+        } else {
+            heap_.reset();
+            data_ = size ? buffer_ : (Real*)(0);
+        }
+        n_ = size;
+    }
+
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : data_((Real*)(0)), n_(0) {
+        allocate(size);
+    }
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_((Real*)(0)), n_(0) {
+        allocate(size);
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_((Real*)(0)), n_(0) {
+        allocate(size);
         for (iterator i=begin(); i!=end(); ++i, value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
+    : data_((Real*)(0)), n_(0) {
+        allocate(from.n_);
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (n_)
         #endif
@@ -238,8 +337,6 @@ namespace QuantLib {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::true_type&) {
             // we got redirected here from a call like Array(3, 4)
@@ -248,34 +345,32 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
-            std::fill(a.begin(),a.end(),value);
+            Array temp(n, value);
+            a.swap(temp);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
-                                 Size& n_,
                                  I begin, I end,
                                  const boost::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
-            n_ = n;
+            Array temp(n);
             #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-            if (n_)
+            if (n)
             #endif
-            std::copy(begin, end, a.begin());
+            std::copy(begin, end, temp.begin());
+            a.swap(temp);
         }
 
     }
 
     template <class ForwardIterator>
-    inline Array::Array(ForwardIterator begin, ForwardIterator end) {
+    inline Array::Array(ForwardIterator begin, ForwardIterator end)
+    : data_((Real*)(0)), n_(0) {
         // Unfortunately, calls such as Array(3, 4) match this constructor.
         // We have to detect integral types and dispatch.
-        detail::_fill_array_(*this, data_, n_, begin, end,
+        detail::_fill_array_(*this, begin, end,
                              boost::is_integral<ForwardIterator>());
     }
 
@@ -366,28 +461,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::at(Size i) const {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real Array::front() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real Array::back() const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Real& Array::operator[](Size i) {
@@ -396,28 +491,28 @@ namespace QuantLib {
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
         #endif
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::at(Size i) {
         QL_REQUIRE(i<n_,
                    "index (" << i << ") must be less than " << n_ <<
                    ": array access out of range");
-        return data_.get()[i];
+        return data_[i];
     }
 
     inline Real& Array::front() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[0];
+        return data_[0];
     }
 
     inline Real& Array::back() {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(n_>0, "null Array: array access out of range");
         #endif
-        return data_.get()[n_-1];
+        return data_[n_-1];
     }
 
     inline Size Array::size() const {
@@ -429,19 +524,19 @@ namespace QuantLib {
     }
 
     inline Array::const_iterator Array::begin() const {
-        return data_.get();
+        return data_;
     }
 
     inline Array::iterator Array::begin() {
-        return data_.get();
+        return data_;
     }
 
     inline Array::const_iterator Array::end() const {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::iterator Array::end() {
-        return data_.get()+n_;
+        return data_+n_;
     }
 
     inline Array::const_reverse_iterator Array::rbegin() const {
@@ -462,7 +557,25 @@ namespace QuantLib {
 
     inline void Array::swap(Array& from) {
         using std::swap;
-        data_.swap(from.data_);
+        if (data_ == buffer_ || from.data_ == from.buffer_) {
+            // inline elements must be copied; heap storage is
+            // still exchanged by swapping pointers
+            Real temp[inlineSize];
+            bool inlined = (data_ == buffer_),
+                 fromInlined = (from.data_ == from.buffer_);
+            if (inlined)
+                std::copy(buffer_, buffer_+n_, temp);
+            if (fromInlined)
+                std::copy(from.buffer_, from.buffer_+from.n_, buffer_);
+            if (inlined)
+                std::copy(temp, temp+n_, from.buffer_);
+            Real* data = fromInlined ? buffer_ : from.data_;
+            from.data_ = inlined ? from.buffer_ : data_;
+            data_ = data;
+        } else {
+            swap(data_,from.data_);
+        }
+        heap_.swap(from.heap_);
         swap(n_,from.n_);
     }
 
@@ -594,6 +707,165 @@ namespace QuantLib {
         return result;
     }
 
+    // operators on temporaries
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v) {
+        Array result = v;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::negate<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        Array result = v1;
+        result += v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        result += v1;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v1;
+        result += v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result = v1;
+        result += a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        result += a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        Array result = v1;
+        result -= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be subtracted");
+        Array result = v2;
+        std::transform(v1.begin(),v1.end(),result.begin(),result.begin(),
+                       std::minus<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v1;
+        result -= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result = v1;
+        result -= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::bind1st(std::minus<Real>(),a));
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        Array result = v1;
+        result *= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        result *= v1;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v1;
+        result *= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result = v1;
+        result *= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        result *= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             const Array& v2) {
+        Array result = v1;
+        result /= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Array& v1,
+                                             const Disposable<Array>& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be divided");
+        Array result = v2;
+        std::transform(v1.begin(),v1.end(),result.begin(),result.begin(),
+                       std::divides<Real>());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             const Disposable<Array>& v2) {
+        Array result = v1;
+        result /= v2;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Disposable<Array>& v1,
+                                             Real a) {
+        Array result = v1;
+        result /= a;
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(Real a,
+                                             const Disposable<Array>& v2) {
+        Array result = v2;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::bind1st(std::divides<Real>(),a));
+        return result;
+    }
+
     // functions
 
     inline const Disposable<Array> Abs(const Array& v) {
@@ -632,6 +904,42 @@ namespace QuantLib {
         return result;
     }
 
+    inline const Disposable<Array> Abs(const Disposable<Array>& v) {
+        Array result = v;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::ptr_fun<Real,Real>(std::fabs));
+        return result;
+    }
+
+    inline const Disposable<Array> Sqrt(const Disposable<Array>& v) {
+        Array result = v;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::ptr_fun<Real,Real>(std::sqrt));
+        return result;
+    }
+
+    inline const Disposable<Array> Log(const Disposable<Array>& v) {
+        Array result = v;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::ptr_fun<Real,Real>(std::log));
+        return result;
+    }
+
+    inline const Disposable<Array> Exp(const Disposable<Array>& v) {
+        Array result = v;
+        std::transform(result.begin(),result.end(),result.begin(),
+                       std::ptr_fun<Real,Real>(std::exp));
+        return result;
+    }
+
+    inline const Disposable<Array> Pow(const Disposable<Array>& v,
+                                       Real alpha) {
+        Array result = v;
+        std::transform(result.begin(), result.end(), result.begin(),
+            std::bind2nd(std::ptr_fun<Real, Real, Real>(std::pow), alpha));
+        return result;
+    }
+
 
     inline void swap(Array& v, Array& w) {
         v.swap(w);
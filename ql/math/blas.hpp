@@ -0,0 +1,65 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blas.hpp
+    \brief prototypes of the BLAS and LAPACK routines used by the library
+
+    The routines are only used if QL_USE_BLAS is defined, in which
+    case the library must be linked to a BLAS and LAPACK
+    implementation exporting the Fortran interface.  Matrices are
+    stored by rows in the library and by columns in Fortran; the
+    callers take care of the conversion, usually by working on the
+    transposed problem.
+*/
+
+#ifndef quantlib_blas_hpp
+#define quantlib_blas_hpp
+
+#include <ql/types.hpp>
+
+#if defined(QL_USE_BLAS)
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+BOOST_STATIC_ASSERT((boost::is_same<QuantLib::Real, double>::value));
+
+extern "C" {
+
+    void dgemm_(const char* transa, const char* transb,
+                const int* m, const int* n, const int* k,
+                const double* alpha, const double* a, const int* lda,
+                const double* b, const int* ldb,
+                const double* beta, double* c, const int* ldc);
+
+    void dgemv_(const char* trans, const int* m, const int* n,
+                const double* alpha, const double* a, const int* lda,
+                const double* x, const int* incx,
+                const double* beta, double* y, const int* incy);
+
+    void dpotrf_(const char* uplo, const int* n,
+                 double* a, const int* lda, int* info);
+
+    void dsyev_(const char* jobz, const char* uplo, const int* n,
+                double* a, const int* lda, double* w,
+                double* work, const int* lwork, int* info);
+
+}
+
+#endif
+
+#endif
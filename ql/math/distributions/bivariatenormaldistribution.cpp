@@ -45,7 +45,9 @@ namespace QuantLib {
 
     BivariateCumulativeNormalDistributionDr78::
     BivariateCumulativeNormalDistributionDr78(Real rho)
-    : rho_(rho), rho2_(rho*rho) {
+    : rho_(rho), rho2_(rho*rho),
+      scale_(std::sqrt(2.0 * (1.0 - rho2_))),
+      factor_(std::sqrt(1.0 - rho2_)/M_PI) {
 
         QL_REQUIRE(rho>=-1.0,
                    "rho must be >= -1.0 (" << rho << " not allowed)");
@@ -68,21 +70,29 @@ namespace QuantLib {
         if (MinCumNormDistAB<1e-15)
             return MinCumNormDistAB;
 
-        Real a1 = a / std::sqrt(2.0 * (1.0 - rho2_));
-        Real b1 = b / std::sqrt(2.0 * (1.0 - rho2_));
+        Real a1 = a / scale_;
+        Real b1 = b / scale_;
 
         Real result=-1.0;
 
         if (a<=0.0 && b<=0 && rho_<=0) {
+            // the parts of the exponent depending on a single index
+            // are calculated once; the exponent is still evaluated
+            // as a1*(2y_i-a1) + b1*(2y_j-b1) + 2 rho (y_i-a1)*(y_j-b1)
+            Real ai[5], bj[5], ci[5], dj[5];
+            for (Size i=0; i<5; i++) {
+                ai[i] = a1*(2.0*y_[i]-a1);
+                bj[i] = b1*(2.0*y_[i]-b1);
+                ci[i] = 2.0*rho_*(y_[i]-a1);
+                dj[i] = y_[i]-b1;
+            }
             Real sum=0.0;
             for (Size i=0; i<5; i++) {
                 for (Size j=0;j<5; j++) {
-                    sum += x_[i]*x_[j]*
-                        std::exp(a1*(2.0*y_[i]-a1)+b1*(2.0*y_[j]-b1)
-                                 +2.0*rho_*(y_[i]-a1)*(y_[j]-b1));
+                    sum += x_[i]*x_[j]*std::exp(ai[i]+bj[j]+ci[i]*dj[j]);
                 }
             }
-            result = std::sqrt(1.0 - rho2_)/M_PI*sum;
+            result = factor_*sum;
         } else if (a<=0 && b>=0 && rho_>=0) {
             BivariateCumulativeNormalDistributionDr78 bivCumNormalDist(-rho_);
             result= CumNormDistA - bivCumNormalDist(a, -b);
@@ -110,57 +120,71 @@ namespace QuantLib {
         return result;
     }
 
+    void BivariateCumulativeNormalDistributionDr78::operator()(
+                                              const Real* a, const Real* b,
+                                              Size n, Real* result) const {
+        for (Size i=0; i<n; ++i)
+            result[i] = (*this)(a[i], b[i]);
+    }
 
-    // West 2004
-
-    namespace {
-
-        class eqn3 { /* Relates to eqn3 Genz 2004 */
-          public:
-            eqn3(Real h, Real k, Real asr) {
-                hk_ = h * k;
-                hs_  = (h * h + k * k) / 2;
-                asr_ = asr;
-            }
-            Real operator()(Real x) const {
-                Real sn = std::sin(asr_ * (-x + 1) * 0.5);
-                return std::exp((sn * hk_ - hs_) / (1.0 - sn * sn));
-            }
-          private:
-            Real hk_, asr_, hs_;
-        };
-
-        class eqn6 { /* Relates to eqn6 Genz 2004 */
-          public:
-            eqn6(Real a, Real c, Real d, Real bs, Real hk)
-            : a_(a), c_(c), d_(d), bs_(bs), hk_(hk) {}
-            Real operator()(Real x) const {
-                Real xs = a_ * (-x + 1);
-                xs = std::fabs(xs*xs);
-                Real rs = std::sqrt(1 - xs);
-                Real asr = -(bs_ / xs + hk_) / 2;
-                if (asr > -100.0) {
-                    return (a_ * std::exp(asr) *
-                            (std::exp(-hk_ * (1 - rs) / (2 * (1 + rs))) / rs -
-                             (1 + c_ * xs * (1 + d_ * xs))));
-                } else {
-                    return 0.0;
-                }
-            }
-          private:
-            Real a_, c_, d_, bs_, hk_;
-        };
 
-    }
+    // West 2004
 
     BivariateCumulativeNormalDistributionWe04DP::
     BivariateCumulativeNormalDistributionWe04DP(Real rho)
-    : correlation_(rho) {
+    : correlation_(rho), asr_(0.0), ass_(0.0), a_(0.0) {
 
         QL_REQUIRE(rho>=-1.0,
                    "rho must be >= -1.0 (" << rho << " not allowed)");
         QL_REQUIRE(rho<=1.0,
                    "rho must be <= 1.0 (" << rho << " not allowed)");
+
+        TabulatedGaussLegendre gaussLegendreQuad(20);
+        if (std::fabs(correlation_) < 0.3) {
+            gaussLegendreQuad.order(6);
+        } else if (std::fabs(correlation_) < 0.75) {
+            gaussLegendreQuad.order(12);
+        }
+
+        // the nodes are listed in the order used by
+        // TabulatedGaussLegendre, so that the terms of the
+        // quadrature are added in the same order
+        std::vector<Real> nodes;
+        const Real* x = gaussLegendreQuad.x();
+        const Real* w = gaussLegendreQuad.weights();
+        Size start = 0;
+        if (gaussLegendreQuad.order() % 2 == 1) {
+            nodes.push_back(x[0]);
+            weights_.push_back(w[0]);
+            start = 1;
+        }
+        for (Size i=start; i<gaussLegendreQuad.size(); ++i) {
+            nodes.push_back(x[i]);
+            weights_.push_back(w[i]);
+            nodes.push_back(-x[i]);
+            weights_.push_back(w[i]);
+        }
+
+        if (std::fabs(correlation_) < 0.925) {
+            if (std::fabs(correlation_) > 0) {
+                asr_ = std::asin(correlation_);
+                for (Size i=0; i<nodes.size(); ++i) {
+                    Real sn = std::sin(asr_ * (-nodes[i] + 1) * 0.5);
+                    sn_.push_back(sn);
+                    cs_.push_back(1.0 - sn * sn);
+                }
+            }
+        } else if (std::fabs(correlation_) < 1) {
+            ass_ = (1 - correlation_) * (1 + correlation_);
+            a_ = std::sqrt(ass_);
+            Real a = a_ / 2;
+            for (Size i=0; i<nodes.size(); ++i) {
+                Real xs = a * (-nodes[i] + 1);
+                xs = std::fabs(xs*xs);
+                xs_.push_back(xs);
+                rs_.push_back(std::sqrt(1 - xs));
+            }
+        }
     }
 
 
@@ -175,20 +199,12 @@ namespace QuantLib {
            www.sci.wsu.edu/math/faculty/henz/homepage)
 
            The Gauss-Legendre quadrature have been extracted to
-           TabulatedGaussLegendre (x,w zero-based)
-
-           Tthe functions ot be integrated numerically have been moved
-           to classes eqn3 and eqn6
+           TabulatedGaussLegendre (x,w zero-based); its nodes and the
+           parts of the integrands of eqn. 3 and 6 that only depend
+           on the correlation are calculated in the constructor
 
            Change some magic numbers to M_PI */
 
-        TabulatedGaussLegendre gaussLegendreQuad(20);
-        if (std::fabs(correlation_) < 0.3) {
-            gaussLegendreQuad.order(6);
-        } else if (std::fabs(correlation_) < 0.75) {
-            gaussLegendreQuad.order(12);
-        }
-
         Real h = -x;
         Real k = -y;
         Real hk = h * k;
@@ -198,10 +214,11 @@ namespace QuantLib {
         {
             if (std::fabs(correlation_) > 0)
             {
-                Real asr = std::asin(correlation_);
-                eqn3 f(h,k,asr);
-                BVN = gaussLegendreQuad(f);
-                BVN *= asr * (0.25 / M_PI);
+                // eqn. 3
+                Real hs = (h * h + k * k) / 2;
+                for (Size i=0; i<weights_.size(); ++i)
+                    BVN += weights_[i] * std::exp((sn_[i] * hk - hs) / cs_[i]);
+                BVN *= asr_ * (0.25 / M_PI);
             }
             BVN += cumnorm_(-h) * cumnorm_(-k);
         }
@@ -214,8 +231,8 @@ namespace QuantLib {
             }
             if (std::fabs(correlation_) < 1)
             {
-                Real Ass = (1 - correlation_) * (1 + correlation_);
-                Real a = std::sqrt(Ass);
+                Real Ass = ass_;
+                Real a = a_;
                 Real bs = (h-k)*(h-k);
                 Real c = (4 - hk) / 8;
                 Real d = (12 - hk) / 16;
@@ -234,8 +251,18 @@ namespace QuantLib {
                         (1 - c * bs * (1 - d * bs / 5) / 3);
                 }
                 a /= 2;
-                eqn6 f(a,c,d,bs,hk);
-                BVN += gaussLegendreQuad(f);
+                // eqn. 6
+                Real integral = 0.0;
+                for (Size i=0; i<weights_.size(); ++i) {
+                    Real xs = xs_[i], rs = rs_[i];
+                    Real asx = -(bs / xs + hk) / 2;
+                    if (asx > -100.0) {
+                        integral += weights_[i] * (a * std::exp(asx) *
+                            (std::exp(-hk * (1 - rs) / (2 * (1 + rs))) / rs -
+                             (1 + c * xs * (1 + d * xs))));
+                    }
+                }
+                BVN += integral;
                 BVN /= (-2.0 * M_PI);
             }
 
@@ -258,4 +285,11 @@ namespace QuantLib {
         return BVN;
     }
 
+    void BivariateCumulativeNormalDistributionWe04DP::operator()(
+                                              const Real* a, const Real* b,
+                                              Size n, Real* result) const {
+        for (Size i=0; i<n; ++i)
+            result[i] = (*this)(a[i], b[i]);
+    }
+
 }
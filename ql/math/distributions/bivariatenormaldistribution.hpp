@@ -26,6 +26,7 @@
 #define quantlib_bivariatenormal_distribution_hpp
 
 #include <ql/math/distributions/normaldistribution.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -53,16 +54,30 @@ namespace QuantLib {
                 `Numerical Computation of the Multivariate Normal
                  Probabilities', J. Comput. Graph. Stat. 1, pp. 141-150.
 
+        The quantities depending on the correlation only are
+        calculated once at construction; instances should therefore
+        be reused when many points are evaluated with the same
+        correlation.
+
         \test the correctness of the returned value is tested by
-              checking it against known good results.
+              checking it against known good results; the results for
+              arrays of points are checked against those of operator().
     */
     class BivariateCumulativeNormalDistributionDr78 {
       public:
         BivariateCumulativeNormalDistributionDr78(Real rho);
         // function
         Real operator()(Real a, Real b) const;
+        //! calculates the values at the n points (a[i],b[i])
+        /*! The results, stored in result, are the same as those of
+            operator(); result can point to the same buffer as a or b.
+        */
+        void operator()(const Real* a, const Real* b, Size n,
+                        Real* result) const;
       private:
         Real rho_, rho2_;
+        // sqrt(2(1-rho^2)) and sqrt(1-rho^2)/pi
+        Real scale_, factor_;
         static const Real x_[], y_[];
     };
 
@@ -85,18 +100,42 @@ namespace QuantLib {
         - The implementation of the cumulative normal distribution is
           QuantLib::CumulativeNormalDistribution
         - The arrays XX and W are zero-based
+        - The Gauss-Legendre nodes and the parts of the integrands
+          depending on the correlation only are calculated once at
+          construction.  Instances should therefore be reused when
+          many points are evaluated with the same correlation; the
+          results are the same as those of the original code.
 
         \test the correctness of the returned value is tested by
-              checking it against known good results.
+              checking it against known good results; the results for
+              arrays of points are checked against those of operator().
     */
     class BivariateCumulativeNormalDistributionWe04DP {
       public:
         BivariateCumulativeNormalDistributionWe04DP(Real rho);
         // function
         Real operator()(Real a, Real b) const;
+        //! calculates the values at the n points (a[i],b[i])
+        /*! The results, stored in result, are the same as those of
+            operator(); result can point to the same buffer as a or b.
+        */
+        void operator()(const Real* a, const Real* b, Size n,
+                        Real* result) const;
       private:
         Real correlation_;
         CumulativeNormalDistribution cumnorm_;
+        // Gauss-Legendre weights, with the corresponding nodes
+        // listed as x_0, -x_0, x_1, -x_1...
+        std::vector<Real> weights_;
+        // for |rho| < 0.925: asin(rho), and sin(asin(rho)(1-x)/2)
+        // and 1-sin^2 at each node x (Genz, eqn. 3)
+        Real asr_;
+        std::vector<Real> sn_, cs_;
+        // otherwise: 1-rho^2, its square root, and the squared
+        // abscissa xs = (1-rho^2)(1-x)^2/4 and sqrt(1-xs) at each
+        // node (Genz, eqn. 6)
+        Real ass_, a_;
+        std::vector<Real> xs_, rs_;
     };
 
     //! default bivariate implementation
@@ -22,6 +22,9 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -63,6 +66,112 @@ namespace QuantLib {
         return result;
     }
 
+    namespace {
+
+        // the arrays are processed in blocks of this size
+        const Size blockSize = 64;
+
+        /* Exponential written without branches and library calls,
+           so that the compiler can vectorise the loops using it; the
+           argument is reduced to |r| <= ln(2)/2 and the Taylor series
+           of exp(r) is truncated after 14 terms.  The relative error
+           is below 3e-16 for |x| < 708; no check is performed, and
+           the result is meaningless outside that range.
+        */
+        inline Real blockExp(Real x) {
+            // adding 2^52+2^51 rounds x/ln(2) to the nearest integer k,
+            // which ends up in the low bits of the sum
+            const Real shift = 6755399441055744.0;
+            Real t = x*1.4426950408889634 + shift;
+            Real k = t - shift;
+            Real r = (x - k*6.93147180369123816490e-01)
+                   - k*1.90821492927058770002e-10;
+            Real p = 1.6059043836821613e-10;
+            p = p*r + 2.08767569878681e-09;
+            p = p*r + 2.505210838544172e-08;
+            p = p*r + 2.755731922398589e-07;
+            p = p*r + 2.7557319223985893e-06;
+            p = p*r + 2.48015873015873e-05;
+            p = p*r + 0.0001984126984126984;
+            p = p*r + 0.001388888888888889;
+            p = p*r + 0.008333333333333333;
+            p = p*r + 0.041666666666666664;
+            p = p*r + 0.16666666666666666;
+            p = p*r + 0.5;
+            p = p*r + 1.0;
+            p = p*r + 1.0;
+            // multiply by 2^k by building its exponent bits
+            // (the high bits of t are shifted out, so the shift is
+            // done on an unsigned integer to keep it well defined)
+            boost::uint64_t bits;
+            std::memcpy(&bits, &t, sizeof(Real));
+            bits = (bits + 1023) << 52;
+            Real scale;
+            std::memcpy(&scale, &bits, sizeof(Real));
+            return p*scale;
+        }
+
+        /* Left tail of the standard cumulative normal distribution
+           for x >= 4, by means of the continued fraction
+           1/(x+1/(x+2/(x+3/(x+...)))) for the Mills ratio; 24 terms
+           are enough for double precision in this range.
+        */
+        Real cumulativeNormalTail(Real x) {
+            Real f = x;
+            for (Integer i=24; i>0; --i)
+                f = x + i/f;
+            return std::exp(-0.5*x*x)/(f*M_SQRT2*M_SQRTPI);
+        }
+
+    }
+
+    void CumulativeNormalDistribution::operator()(const Real* x, Size n,
+                                                  Real* y) const {
+        Real z[blockSize];
+        for (Size start=0; start<n; start+=blockSize) {
+            const Size m = std::min(blockSize, n-start);
+            const Real* xs = x+start;
+            Real* ys = y+start;
+
+            // Hart's rational approximation (see G. West, "Better
+            // approximations to cumulative normal functions", 2005)
+            for (Size i=0; i<m; ++i) {
+                z[i] = (xs[i]-average_)/sigma_;
+                Real a = std::fabs(z[i]);
+                Real p = ((((((3.52624965998911e-02*a
+                               + 0.700383064443688)*a
+                              + 6.37396220353165)*a
+                             + 33.912866078383)*a
+                            + 112.079291497871)*a
+                           + 221.213596169931)*a
+                          + 220.206867912376);
+                Real q = (((((((8.83883476483184e-02*a
+                                + 1.75566716318264)*a
+                               + 16.064177579207)*a
+                              + 86.7807322029461)*a
+                             + 296.564248779674)*a
+                            + 637.333633378831)*a
+                           + 793.826512519948)*a
+                          + 440.413735824752);
+                Real tail = blockExp(-0.5*a*a)*p/q;
+                // 1-tail for positive z, written as a blend instead of
+                // a branch
+                Real positive = z[i] > 0.0;
+                ys[i] = positive + (1.0-2.0*positive)*tail;
+            }
+
+            // the approximation loses relative accuracy in the tails,
+            // where the above (including the exponential) is replaced
+            for (Size i=0; i<m; ++i) {
+                Real a = std::fabs(z[i]);
+                if (a >= 4.0) {
+                    Real tail = a < 40.0 ? cumulativeNormalTail(a) : 0.0;
+                    ys[i] = z[i] > 0.0 ? 1.0-tail : tail;
+                }
+            }
+        }
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -126,6 +235,58 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::standard_values(const Real* x, Size n,
+                                                  Real* y,
+                                                  Accuracy accuracy) {
+        Real u[blockSize], p[blockSize];
+        CumulativeNormalDistribution f;
+        for (Size start=0; start<n; start+=blockSize) {
+            const Size m = std::min(blockSize, n-start);
+            std::copy(x+start, x+start+m, u);
+            Real* ys = y+start;
+
+            // central region, evaluated for all points
+            for (Size i=0; i<m; ++i) {
+                Real z = u[i] - 0.5;
+                Real r = z*z;
+                ys[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+
+            // tails
+            for (Size i=0; i<m; ++i) {
+                if (u[i] < x_low_ || x_high_ < u[i])
+                    ys[i] = tail_value(u[i]);
+            }
+
+            if (accuracy == Refined) {
+                f(ys, m, p);
+                for (Size i=0; i<m; ++i) {
+                    // the extreme values (including those returned for
+                    // 0 and 1) are kept; branches are replaced by blends
+                    Real z = ys[i];
+                    Real keep = std::fabs(z) >= 37.0;
+                    z = keep*37.0*(z > 0.0 ? 1.0 : -1.0) + (1.0-keep)*z;
+                    // error (f(z) - x) divided by the cumulative's
+                    // derivative, and Halley's method
+                    Real r = (p[i]-u[i]) * M_SQRT2 * M_SQRTPI
+                           * blockExp(0.5*z*z);
+                    Real refined = z - r/(1.0+0.5*z*r);
+                    ys[i] = keep*ys[i] + (1.0-keep)*refined;
+                }
+            }
+        }
+    }
+
+    void InverseCumulativeNormal::operator()(const Real* x, Size n, Real* y,
+                                             Accuracy accuracy) const {
+        standard_values(x, n, y, accuracy);
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            for (Size i=0; i<n; ++i)
+                y[i] = average_ + sigma_*y[i];
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
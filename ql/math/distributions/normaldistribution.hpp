@@ -73,6 +73,17 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        //! calculates the values at the n points in x and stores them in y
+        /*! The points are processed in blocks: Hart's rational
+            approximation is evaluated over each block without
+            branches, and the few points beyond four standard
+            deviations are corrected afterwards by means of a
+            continued fraction.  The results have a relative
+            accuracy of about 1e-13 (also in the left tail) and can
+            differ from those of operator() in the last digits.  x
+            and y can point to the same buffer.
+        */
+        void operator()(const Real* x, Size n, Real* y) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -101,12 +112,25 @@ namespace QuantLib {
     class InverseCumulativeNormal
         : public std::unary_function<Real,Real> {
       public:
+        //! accuracy of the results for arrays of points
+        enum Accuracy {
+            Approximated, /*!< Acklam's approximation, with a relative
+                               error below 1.15e-9; the results are
+                               the same as those of operator(). */
+            Refined       /*!< one step of Halley's method is applied
+                               to the approximation, which brings the
+                               error down to about 1e-13. */
+        };
         InverseCumulativeNormal(Real average = 0.0,
                                 Real sigma   = 1.0);
         // function
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        //! calculates the values at the n points in x and stores them in y
+        /*! x and y can point to the same buffer. */
+        void operator()(const Real* x, Size n, Real* y,
+                        Accuracy accuracy = Approximated) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -136,6 +160,14 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for average=0, sigma=1 at the n points in x
+        /*! The points are processed in blocks: the rational
+            approximation for the central region is evaluated over
+            each block without branches, and the few points in the
+            tails are corrected afterwards.
+        */
+        static void standard_values(const Real* x, Size n, Real* y,
+                                    Accuracy accuracy = Approximated);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
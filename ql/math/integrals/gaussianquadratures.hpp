@@ -230,6 +230,14 @@ namespace QuantLib {
 
         void order(Size);
         Size order() const { return order_; }
+        //! number of tabulated abscissas
+        Size size() const { return n_; }
+        //! tabulated non-negative abscissas
+        /*! The rule also uses their opposites, except for the null
+            abscissa of odd orders.
+        */
+        const Real* x() const { return x_; }
+        const Real* weights() const { return w_; }
 
       private:
         Size order_;
@@ -52,6 +52,15 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            //! values at several points
+            /*! The default implementation calls value() for each
+                point; implementations can override it to locate
+                sorted points in a single pass.
+            */
+            virtual void values(const Real* x, Size n, Real* y) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -105,6 +114,18 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! same as locate(x), but the search starts from the
+                interval returned for a previous point; this is
+                faster when the points are sorted.
+            */
+            Size locate(Real x, Size previous) const {
+                if (x < xBegin_[previous])
+                    return locate(x);
+                Size i = previous, n = xEnd_-xBegin_;
+                while (i < n-2 && x >= xBegin_[i+1])
+                    ++i;
+                return i;
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -116,6 +137,14 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        //! values at the n points starting at x
+        /*! Sorted points are located in a single pass. */
+        void values(const Real* x, Size n, Real* y,
+                    bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->values(x, n, y);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -321,6 +321,11 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            void values(const Real* x, Size n, Real* y) const {
+                interpolation_.values(x, n, y, true);
+                for (Size i=0; i<n; ++i)
+                    y[i] = std::exp(y[i]);
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
@@ -22,6 +22,8 @@
 */
 
 #include <ql/math/matrix.hpp>
+#include <ql/math/blas.hpp>
+#include <algorithm>
 #if defined(QL_PATCH_MSVC)
 #pragma warning(push)
 #pragma warning(disable:4180)
@@ -62,6 +64,97 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        void matrixProduct(const Matrix& m1, const Matrix& m2,
+                           Matrix& result) {
+            const Size rows = m1.rows(), inner = m1.columns(),
+                       columns = m2.columns();
+            if (rows == 0 || inner == 0 || columns == 0)
+                return;
+
+            #if defined(QL_USE_BLAS)
+            if (rows*inner*columns >= blasThreshold) {
+                // the row-major product C = A B is the column-major
+                // product C^T = B^T A^T
+                const int m = int(columns), n = int(rows), k = int(inner);
+                const double one = 1.0, zero = 0.0;
+                dgemm_("N", "N", &m, &n, &k, &one, m2.begin(), &m,
+                       m1.begin(), &k, &zero, result.begin(), &m);
+                return;
+            }
+            #endif
+
+            /* The product is calculated on blocks that fit in the
+               cache.  For each element of the result, the terms are
+               still added in order of increasing k, so that the
+               result is the same as that of the plain triple loop. */
+            const Size blockSize = 64;
+            const long rowBlocks = long((rows + blockSize - 1)/blockSize);
+#pragma omp parallel for default(shared) if(rows*inner*columns > 1000000)
+            for (long b=0; b<rowBlocks; ++b) {
+                const Size i0 = Size(b)*blockSize,
+                           i1 = std::min(i0+blockSize, rows);
+                for (Size k0=0; k0<inner; k0+=blockSize) {
+                    const Size k1 = std::min(k0+blockSize, inner);
+                    for (Size j0=0; j0<columns; j0+=blockSize) {
+                        const Size j1 = std::min(j0+blockSize, columns);
+                        for (Size i=i0; i<i1; ++i) {
+                            Matrix::row_iterator r = result.row_begin(i);
+                            Matrix::const_row_iterator a = m1.row_begin(i);
+                            for (Size k=k0; k<k1; ++k) {
+                                const Real aik = a[k];
+                                Matrix::const_row_iterator c =
+                                    m2.row_begin(k);
+                                for (Size j=j0; j<j1; ++j)
+                                    r[j] += aik*c[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void matrixVectorProduct(const Matrix& m, const Array& v,
+                                 Array& result) {
+            #if defined(QL_USE_BLAS)
+            if (m.rows() > 0 && m.columns() > 0) {
+                // the row-major matrix is its column-major transpose
+                const int rows = int(m.columns()), cols = int(m.rows());
+                const int inc = 1;
+                const double one = 1.0, zero = 0.0;
+                dgemv_("T", &rows, &cols, &one, m.begin(), &rows,
+                       v.begin(), &inc, &zero, result.begin(), &inc);
+                return;
+            }
+            #endif
+            for (Size i=0; i<result.size(); i++)
+                result[i] =
+                    std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
+        }
+
+        void vectorMatrixProduct(const Array& v, const Matrix& m,
+                                 Array& result) {
+            #if defined(QL_USE_BLAS)
+            if (m.rows() > 0 && m.columns() > 0) {
+                const int rows = int(m.columns()), cols = int(m.rows());
+                const int inc = 1;
+                const double one = 1.0, zero = 0.0;
+                dgemv_("N", &rows, &cols, &one, m.begin(), &rows,
+                       v.begin(), &inc, &zero, result.begin(), &inc);
+                return;
+            }
+            #endif
+            std::fill(result.begin(), result.end(), 0.0);
+            for (Size i=0; i<m.rows(); i++) {
+                Matrix::const_row_iterator row = m.row_begin(i);
+                for (Size j=0; j<result.size(); j++)
+                    result[j] += v[i]*row[j];
+            }
+        }
+
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
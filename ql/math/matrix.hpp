@@ -35,6 +35,9 @@ namespace QuantLib {
     /*! This class implements the concept of Matrix as used in linear
         algebra. As such, it is <b>not</b> meant to be used as a
         container.
+
+        The elements are stored by rows in a contiguous block aligned
+        to a 64-byte boundary.
     */
     class Matrix {
       public:
@@ -137,7 +140,7 @@ namespace QuantLib {
         void swap(Matrix&);
         //@}
       private:
-        boost::scoped_array<Real> data_;
+        AlignedArray<Real> data_;
         Size rows_, columns_;
     };
 
@@ -189,31 +192,51 @@ namespace QuantLib {
     /*! \relates Matrix */
     Real determinant(const Matrix& m);
 
+    namespace detail {
+
+        /* Kernels for products of larger matrices, defined in
+           matrix.cpp.  They go through BLAS if the library was
+           configured with QL_USE_BLAS; otherwise, the matrix product
+           is cache-blocked and its row blocks are calculated in
+           parallel if OpenMP is enabled.  The result must be
+           allocated by the caller, and filled with zeros for the
+           matrix product. */
+        void matrixProduct(const Matrix& m1, const Matrix& m2,
+                           Matrix& result);
+        void matrixVectorProduct(const Matrix& m, const Array& v,
+                                 Array& result);
+        void vectorMatrixProduct(const Array& v, const Matrix& m,
+                                 Array& result);
+
+        #if defined(QL_USE_BLAS)
+        // below this number of multiplications, BLAS isn't called
+        const Size blasThreshold = 4096;
+        #endif
+
+    }
+
     // inline definitions
 
     inline Matrix::Matrix()
-    : data_((Real*)(0)), rows_(0), columns_(0) {}
+    : rows_(0), columns_(0) {}
 
     inline Matrix::Matrix(Size rows, Size columns)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
-      rows_(rows), columns_(columns) {}
+    : data_(rows*columns), rows_(rows), columns_(columns) {}
 
     inline Matrix::Matrix(Size rows, Size columns, Real value)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
-      rows_(rows), columns_(columns) {
+    : data_(rows*columns), rows_(rows), columns_(columns) {
         std::fill(begin(),end(),value);
     }
 
     template <class Iterator>
     inline Matrix::Matrix(Size rows, Size columns,
                           Iterator begin, Iterator end)
-        : data_(rows * columns > 0 ? new Real[rows * columns] : (Real *)(0)),
-          rows_(rows), columns_(columns) {
+        : data_(rows * columns), rows_(rows), columns_(columns) {
         std::copy(begin, end, this->begin());
     }
 
     inline Matrix::Matrix(const Matrix& from)
-    : data_(!from.empty() ? new Real[from.rows_*from.columns_] : (Real*)(0)),
+    : data_(from.rows_*from.columns_),
       rows_(from.rows_), columns_(from.columns_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (!from.empty())
@@ -222,7 +245,7 @@ namespace QuantLib {
     }
 
     inline Matrix::Matrix(const Disposable<Matrix>& from)
-    : data_((Real*)(0)), rows_(0), columns_(0) {
+    : rows_(0), columns_(0) {
         swap(const_cast<Disposable<Matrix>&>(from));
     }
 
@@ -531,10 +554,20 @@ namespace QuantLib {
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
         Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
+        #if defined(QL_USE_BLAS)
+        if (m.rows()*m.columns() >= detail::blasThreshold) {
+            detail::vectorMatrixProduct(v, m, result);
+            return result;
+        }
+        #endif
+        // the matrix is read by rows instead of by columns; each
+        // element is still summed in the same order
+        std::fill(result.begin(), result.end(), 0.0);
+        for (Size i=0; i<m.rows(); i++) {
+            Matrix::const_row_iterator row = m.row_begin(i);
+            for (Size j=0; j<result.size(); j++)
+                result[j] += v[i]*row[j];
+        }
         return result;
     }
 
@@ -544,6 +577,12 @@ namespace QuantLib {
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
         Array result(m.rows());
+        #if defined(QL_USE_BLAS)
+        if (m.rows()*m.columns() >= detail::blasThreshold) {
+            detail::matrixVectorProduct(m, v, result);
+            return result;
+        }
+        #endif
         for (Size i=0; i<result.size(); i++)
             result[i] =
                 std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
@@ -558,13 +597,7 @@ namespace QuantLib {
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "multiplied");
         Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
-                }
-            }
-        }
+        detail::matrixProduct(m1, m2, result);
         return result;
     }
 
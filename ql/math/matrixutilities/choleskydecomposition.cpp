@@ -20,9 +20,39 @@
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/blas.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        // calculates the (j,i) element of the decomposition, j >= i,
+        // given the elements to its left and those of row i
+        inline void choleskyElement(const Matrix& S, Matrix& result,
+                                    Size i, Size j, bool flexible) {
+            Real sum = S[i][j];
+            for (Integer k=0; k<=Integer(i)-1; k++) {
+                sum -= result[i][k]*result[j][k];
+            }
+            if (i == j) {
+                QL_REQUIRE(flexible || sum > 0.0,
+                           "input matrix is not positive definite");
+                // To handle positive semi-definite matrices take the
+                // square root of sum if positive, else zero.
+                result[i][i] = std::sqrt(std::max<Real>(sum, 0.0));
+            } else {
+                // With positive semi-definite matrices is possible
+                // to have result[i][i]==0.0
+                // In this case sum happens to be zero as well
+                result[j][i] = close_enough(result[i][i], 0.0)
+                                   ? 0.0
+                                   : sum / result[i][i];
+            }
+        }
+
+    }
+
     const Disposable<Matrix> CholeskyDecomposition(const Matrix &S,
                                                    bool flexible) {
         Size i, j, size = S.rows();
@@ -36,29 +66,39 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_USE_BLAS)
+        // LAPACK doesn't handle semi-definite matrices
+        if (!flexible && size*size*size >= detail::blasThreshold) {
+            Matrix result = S;
+            // the lower triangle of a row-major matrix is the upper
+            // triangle of its column-major transpose
+            const int n = int(size);
+            int info = 0;
+            dpotrf_("U", &n, result.begin(), &n, &info);
+            QL_REQUIRE(info == 0, "input matrix is not positive definite");
+            for (i=0; i<size; i++)
+                std::fill(result.row_begin(i)+i+1, result.row_end(i), 0.0);
+            return result;
+        }
+        #endif
+
+        /* The columns are processed in blocks: after the diagonal
+           block is calculated, each of the rows below it is read
+           once per block instead of once per column, and the rows
+           are calculated in parallel if OpenMP is enabled.  The
+           operations on each element are the same as in the
+           unblocked algorithm, and so is the result. */
         Matrix result(size, size, 0.0);
-        Real sum;
-        for (i=0; i<size; i++) {
-            for (j=i; j<size; j++) {
-                sum = S[i][j];
-                for (Integer k=0; k<=Integer(i)-1; k++) {
-                    sum -= result[i][k]*result[j][k];
-                }
-                if (i == j) {
-                    QL_REQUIRE(flexible || sum > 0.0,
-                               "input matrix is not positive definite");
-                    // To handle positive semi-definite matrices take the
-                    // square root of sum if positive, else zero.
-                    result[i][i] = std::sqrt(std::max<Real>(sum, 0.0));
-                } else {
-                    // With positive semi-definite matrices is possible
-                    // to have result[i][i]==0.0
-                    // In this case sum happens to be zero as well
-                    result[j][i] = close_enough(result[i][i], 0.0)
-                                       ? 0.0
-                                       : sum / result[i][i];
-                }
-            }
+        const Size blockSize = 32;
+        for (Size i0=0; i0<size; i0+=blockSize) {
+            const Size i1 = std::min(i0+blockSize, size);
+            for (i=i0; i<i1; i++)
+                for (j=i; j<i1; j++)
+                    choleskyElement(S, result, i, j, flexible);
+#pragma omp parallel for default(shared) if((size-i1)*i1 > 100000)
+            for (long r=long(i1); r<long(size); r++)
+                for (Size c=i0; c<i1; c++)
+                    choleskyElement(S, result, c, Size(r), flexible);
         }
         return result;
     }
@@ -19,6 +19,8 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/blas.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -30,6 +32,32 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+
+        #if defined(QL_USE_BLAS)
+        if (size*size*size >= detail::blasThreshold) {
+            // the matrix is symmetric, so that it's the same in
+            // column-major order; the eigenvectors are returned in
+            // the columns of the column-major result, i.e., in the
+            // rows of the row-major one.
+            Matrix a = s;
+            const int n = int(size), query = -1;
+            int info = 0;
+            double optimalSize;
+            dsyev_("V", "U", &n, a.begin(), &n, diagonal_.begin(),
+                   &optimalSize, &query, &info);
+            const int lwork = std::max(int(optimalSize), 3*n);
+            std::vector<double> work(lwork);
+            dsyev_("V", "U", &n, a.begin(), &n, diagonal_.begin(),
+                   &work[0], &lwork, &info);
+            QL_ENSURE(info == 0,
+                      "eigenvalue decomposition failed (info = "
+                      << info << ")");
+            eigenVectors_ = transpose(a);
+            sortEigenpairs();
+            return;
+        }
+        #endif
+
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
             eigenVectors_[q][q] = 1.0;
@@ -111,7 +139,11 @@ namespace QuantLib {
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
 
+        sortEigenpairs();
+    }
 
+    void SymmetricSchurDecomposition::sortEigenpairs() {
+        Size size = diagonal_.size();
         // sort (eigenvalues, eigenvectors)
         std::vector<std::pair<Real, std::vector<Real> > > temp(size);
         std::vector<Real> eigenVector(size);
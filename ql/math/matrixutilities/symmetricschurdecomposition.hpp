@@ -44,6 +44,13 @@ namespace QuantLib {
         second edition, by Golub and Van Loan,
         The Johns Hopkins University Press
 
+        If the library was configured with QL_USE_BLAS, the
+        decomposition of all but the smallest matrices is calculated
+        by LAPACK instead.  The eigenvalues are the same up to
+        round-off; when some of them are degenerate, the
+        corresponding eigenvectors can be a different basis of the
+        same subspace.
+
         \test the correctness of the returned values is tested by
               checking their properties.
     */
@@ -58,6 +65,9 @@ namespace QuantLib {
         Matrix eigenVectors_;
         void jacobiRotate_(Matrix & m, Real rot, Real dil,
                            Size j1, Size k1, Size j2, Size k2) const;
+        // sorts the eigenvalues in decreasing order and normalizes
+        // the sign of the eigenvectors
+        void sortEigenpairs();
     };
 
 
@@ -31,6 +31,20 @@ namespace QuantLib {
             }
         };
 
+        // draws the shuffles from the optimizer's own generator, so
+        // that the results only depend on the given seed
+        class shuffle_index {
+          public:
+            explicit shuffle_index(const MersenneTwisterUniformRng& rng)
+            : rng_(rng) {}
+            std::ptrdiff_t operator()(std::ptrdiff_t n) {
+                return std::min<std::ptrdiff_t>(
+                               std::ptrdiff_t(rng_.nextReal()*n), n-1);
+            }
+          private:
+            const MersenneTwisterUniformRng& rng_;
+        };
+
     }
 
     EndCriteria::Type DifferentialEvolution::minimize(Problem& p, const EndCriteria& endCriteria) {
@@ -77,15 +91,16 @@ namespace QuantLib {
 
         std::vector<Candidate> mirrorPopulation;
         std::vector<Candidate> oldPopulation = population;
+        shuffle_index shuffle(rng_);
 
         switch (configuration().strategy) {
 
           case Rand1Standard: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop2 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               mirrorPopulation = shuffledPop1;
 
               for (Size popIter = 0; popIter < population.size(); popIter++) {
@@ -97,9 +112,9 @@ namespace QuantLib {
             break;
 
           case BestMemberWithJitter: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               Array jitter(population[0].values.size(), 0.0);
 
               for (Size popIter = 0; popIter < population.size(); popIter++) {
@@ -116,9 +131,9 @@ namespace QuantLib {
             break;
 
           case CurrentToBest2Diffs: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
 
               for (Size popIter = 0; popIter < population.size(); popIter++) {
                   population[popIter].values = oldPopulation[popIter].values
@@ -132,11 +147,11 @@ namespace QuantLib {
             break;
 
           case Rand1DiffWithPerVectorDither: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop2 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               mirrorPopulation = shuffledPop1;
               Array FWeight = Array(population.front().values.size(), 0.0);
               for (Size fwIter = 0; fwIter < FWeight.size(); fwIter++)
@@ -150,11 +165,11 @@ namespace QuantLib {
             break;
 
           case Rand1DiffWithDither: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop2 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               mirrorPopulation = shuffledPop1;
               Real FWeight = (1.0 - configuration().stepsizeWeight) * rng_.nextReal()
                   + configuration().stepsizeWeight;
@@ -166,11 +181,11 @@ namespace QuantLib {
             break;
 
           case EitherOrWithOptimalRecombination: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop2 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               mirrorPopulation = shuffledPop1;
               Real probFWeight = 0.5;
               if (rng_.nextReal() < probFWeight) {
@@ -192,11 +207,11 @@ namespace QuantLib {
             break;
 
           case Rand1SelfadaptiveWithRotation: {
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop1 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               std::vector<Candidate> shuffledPop2 = population;
-              std::random_shuffle(population.begin(), population.end());
+              std::random_shuffle(population.begin(), population.end(), shuffle);
               mirrorPopulation = shuffledPop1;
 
               adaptSizeWeights();
@@ -259,10 +274,22 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
+        }
+
+        evaluate(population, costFunction);
+    }
+
+    void DifferentialEvolution::evaluate(
+                                   std::vector<Candidate>& population,
+                                   const CostFunction& costFunction) const {
+        // the members are independent and can be evaluated
+        // concurrently if so requested; failed evaluations are
+        // discarded by giving them the highest cost
+#pragma omp parallel for default(shared) if(configuration().parallelEvaluation)
+        for (long popIter = 0; popIter < long(population.size()); popIter++) {
             try {
                 population[popIter].cost = costFunction.value(population[popIter].values);
-            } catch (Error&) {
+            } catch (std::exception&) {
                 population[popIter].cost = QL_MAX_REAL;
             }
         }
@@ -312,7 +339,8 @@ namespace QuantLib {
     }
 
     Array DifferentialEvolution::rotateArray(Array a) const {
-        std::random_shuffle(a.begin(), a.end());
+        shuffle_index shuffle(rng_);
+        std::random_shuffle(a.begin(), a.end(), shuffle);
         return a;
     }
 
@@ -344,15 +372,14 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+        evaluate(population, p.costFunction());
     }
 
 }
@@ -55,7 +55,14 @@ namespace QuantLib {
 
 
     //! %OptimizationMethod using Differential Evolution algorithm
-    /*! \ingroup optimizers */
+    /*! Candidates for which the cost function throws an exception
+        are given the cost QL_MAX_REAL, so that they are discarded
+        by the selection.  This applies to the initial population as
+        well as to the following generations, and whether or not
+        they are evaluated in parallel.
+
+        \ingroup optimizers
+    */
     class DifferentialEvolution: public OptimizationMethod {
       public:
         enum Strategy {
@@ -87,6 +94,7 @@ namespace QuantLib {
             Real stepsizeWeight, crossoverProbability;
             unsigned long seed;
             bool applyBounds, crossoverIsAdaptive;
+            bool parallelEvaluation;
 
             Configuration()
             : strategy(BestMemberWithJitter),
@@ -96,7 +104,8 @@ namespace QuantLib {
               crossoverProbability(0.9),
               seed(0),
               applyBounds(true),
-              crossoverIsAdaptive(false) {}
+              crossoverIsAdaptive(false),
+              parallelEvaluation(false) {}
 
             Configuration& withBounds(bool b = true) {
                 applyBounds = b;
@@ -144,6 +153,17 @@ namespace QuantLib {
                 strategy = s;
                 return *this;
             }
+
+            /*! If the library was compiled with OpenMP, the members
+                of each generation are evaluated concurrently; the
+                cost function must then be safe to call from several
+                threads.  Random numbers are still drawn sequentially,
+                so the results don't depend on the number of threads.
+            */
+            Configuration& withParallelEvaluation(bool b = true) {
+                parallelEvaluation = b;
+                return *this;
+            }
         };
 
 
@@ -167,6 +187,9 @@ namespace QuantLib {
         void fillInitialPopulation(std::vector<Candidate>& population,
                                    const Problem& p) const;
 
+        void evaluate(std::vector<Candidate>& population,
+                      const CostFunction& costFunction) const;
+
         void getCrossoverMask(std::vector<Array>& crossoverMask,
                               std::vector<Array>& invCrossoverMask,
                               const Array& mutationProbabilities) const;
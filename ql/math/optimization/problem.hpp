@@ -28,6 +28,8 @@
 
 #include <ql/math/optimization/method.hpp>
 #include <ql/math/optimization/costfunction.hpp>
+#include <string>
+#include <vector>
 
 namespace QuantLib {
 
@@ -46,7 +48,8 @@ namespace QuantLib {
                 Constraint& constraint,
                 const Array& initialValue = Array())
         : costFunction_(costFunction), constraint_(constraint),
-          currentValue_(initialValue) {}
+          currentValue_(initialValue),
+          functionEvaluation_(0), gradientEvaluation_(0) {}
 
         /*! \warning it does not reset the current minumum to any initial value
         */
@@ -58,6 +61,18 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Disposable<Array> values(const Array& x);
 
+        //! call cost function computation at several points and
+        //  increment evaluation counter
+        /*! If parallel is true and the library was compiled with
+            OpenMP, the cost function is evaluated concurrently at
+            the given points and must therefore be safe to call from
+            several threads.  In this case, if any of the evaluations
+            fails, an exception is raised after all of them are
+            completed.
+        */
+        Disposable<Array> value(const std::vector<Array>& x,
+                                bool parallel = false);
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -123,6 +138,35 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline Disposable<Array> Problem::value(const std::vector<Array>& x,
+                                            bool parallel) {
+        functionEvaluation_ += static_cast<Integer>(x.size());
+        Array results(x.size());
+#ifdef _OPENMP
+        if (parallel) {
+            // exceptions can't leave the parallel region; they're
+            // collected and the first one is raised afterwards
+            std::vector<std::string> errors(x.size());
+            std::vector<int> failed(x.size(), 0);
+#pragma omp parallel for default(shared)
+            for (long i=0; i<static_cast<long>(x.size()); ++i) {
+                try {
+                    results[i] = costFunction_.value(x[i]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                    failed[i] = 1;
+                }
+            }
+            for (Size i=0; i<x.size(); ++i)
+                QL_REQUIRE(!failed[i], errors[i]);
+            return results;
+        }
+#endif
+        for (Size i=0; i<x.size(); ++i)
+            results[i] = costFunction_.value(x[i]);
+        return results;
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
@@ -26,6 +26,8 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -61,6 +63,12 @@ namespace QuantLib {
                              const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        //! fills the buffer with the next n samples
+        /*! The samples are stored one after the other, so that the
+            buffer must have room for n times the dimension; their
+            weights are not returned.
+        */
+        void nextSequences(Real* output, Size n) const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
       private:
@@ -96,6 +104,36 @@ namespace QuantLib {
         return x_;
     }
 
+    namespace detail {
+
+        template <class IC>
+        inline void inverseCumulativeValues(const IC& ic, const Real* x,
+                                            Size n, Real* y) {
+            for (Size i=0; i<n; ++i)
+                y[i] = ic(x[i]);
+        }
+
+        inline void inverseCumulativeValues(
+                                       const InverseCumulativeNormal& ic,
+                                       const Real* x, Size n, Real* y) {
+            ic(x, n, y);
+        }
+
+    }
+
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::nextSequences(Real* output,
+                                                             Size n) const {
+        Real* p = output;
+        for (Size j=0; j<n; ++j, p+=dimension_) {
+            const typename USG::sample_type& sample =
+                uniformSequenceGenerator_.nextSequence();
+            std::copy(sample.value.begin(), sample.value.end(), p);
+        }
+        // the whole block is transformed at once
+        detail::inverseCumulativeValues(ICD_, output, n*dimension_, output);
+    }
+
 }
 
 
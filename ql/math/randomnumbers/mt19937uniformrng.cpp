@@ -68,9 +68,119 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        const Size stateBits = 19937;
+
+        /* Characteristic polynomial of the generator, as the list of
+           the exponents of its terms below the leading x^19937.  It
+           is the minimal polynomial of any of the bit sequences in
+           the output, and is retrieved by running the
+           Berlekamp-Massey algorithm on one of them.
+        */
+        std::vector<Size> characteristicTerms() {
+            typedef boost::uint64_t word;
+            const Size n = 2*stateBits, words = n/64 + 2;
+            // the bits are packed in reverse order, so that the
+            // discrepancies below are computed a word at a time
+            std::vector<word> bits(words, 0);
+            MersenneTwisterUniformRng rng(42);
+            for (Size i=0; i<n; ++i) {
+                Size k = n-1-i;
+                bits[k/64] |= word(rng.nextInt32() & 1) << (k%64);
+            }
+
+            std::vector<word> c(words, 0), b(words, 0), t;
+            c[0] = b[0] = 1;
+            Size l = 0, m = 1;
+            for (Size i=0; i<n; ++i) {
+                // discrepancy between the i-th bit and its prediction
+                word d = 0;
+                for (Size q=0; q<=l/64; ++q) {
+                    Size k = n-1-i + 64*q, r = k%64;
+                    word w = bits[k/64] >> r;
+                    if (r != 0)
+                        w |= bits[k/64+1] << (64-r);
+                    d ^= c[q] & w;
+                }
+                for (Size shift=32; shift>0; shift/=2)
+                    d ^= d >> shift;
+                if ((d & 1) == 0) {
+                    ++m;
+                    continue;
+                }
+                if (2*l <= i)
+                    t = c;
+                // c += x^m b
+                Size qm = m/64, r = m%64;
+                for (Size q=0; q+qm<words; ++q) {
+                    c[q+qm] ^= b[q] << r;
+                    if (r != 0 && q+qm+1 < words)
+                        c[q+qm+1] ^= b[q] >> (64-r);
+                }
+                if (2*l <= i) {
+                    l = i+1-l;
+                    b.swap(t);
+                    m = 1;
+                } else {
+                    ++m;
+                }
+            }
+            QL_ENSURE(l == stateBits,
+                      "wrong degree (" << l << ") of the "
+                      "characteristic polynomial");
+
+            // c is the reciprocal of the characteristic polynomial
+            std::vector<Size> terms;
+            for (Size j=stateBits; j>0; --j)
+                if ((c[j/64] >> (j%64)) & 1)
+                    terms.push_back(stateBits-j);
+            return terms;
+        }
+
+        // reduces p, of degree up to 2*(stateBits-1), modulo the
+        // characteristic polynomial
+        void reduce(std::vector<char>& p, const std::vector<Size>& terms) {
+            for (Size i=p.size()-1; i>=stateBits; --i) {
+                if (p[i]) {
+                    p[i] = 0;
+                    for (Size k=0; k<terms.size(); ++k)
+                        p[i-stateBits+terms[k]] ^= 1;
+                }
+            }
+            p.resize(stateBits);
+        }
+
+        // coefficients of x^n modulo the characteristic polynomial
+        std::vector<char> jumpPolynomial(BigNatural n) {
+            static const std::vector<Size> terms = characteristicTerms();
+            std::vector<char> p(stateBits, 0), square(2*stateBits-1);
+            p[0] = 1;
+            BigNatural mask = 1;
+            while (mask <= n/2)
+                mask <<= 1;
+            for (; mask != 0; mask >>= 1) {
+                std::fill(square.begin(), square.end(), 0);
+                for (Size i=0; i<stateBits; ++i)
+                    square[2*i] = p[i];
+                reduce(square, terms);
+                p.swap(square);
+                square.resize(2*stateBits-1);
+                if (n & mask) {
+                    p.insert(p.begin(), 0);
+                    reduce(p, terms);
+                }
+            }
+            return p;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -142,4 +252,95 @@ namespace QuantLib {
         mti = 0;
     }
 
+    void MersenneTwisterUniformRng::nextInt32s(unsigned long* output,
+                                               Size n) const {
+        while (n > 0) {
+            if (mti==N)
+                twist();
+            Size m = std::min(n, N-mti);
+            const boost::uint32_t* state = mt + mti;
+            for (Size i=0; i<m; ++i) {
+                unsigned long y = state[i];
+                y ^= (y >> 11);
+                y ^= (y << 7) & 0x9d2c5680UL;
+                y ^= (y << 15) & 0xefc60000UL;
+                y ^= (y >> 18);
+                output[i] = y;
+            }
+            mti += m;
+            output += m;
+            n -= m;
+        }
+    }
+
+    void MersenneTwisterUniformRng::nextReals(Real* output, Size n) const {
+        while (n > 0) {
+            if (mti==N)
+                twist();
+            Size m = std::min(n, N-mti);
+            const boost::uint32_t* state = mt + mti;
+            for (Size i=0; i<m; ++i) {
+                boost::uint32_t y = state[i];
+                y ^= (y >> 11);
+                y ^= (y << 7) & 0x9d2c5680U;
+                y ^= (y << 15) & 0xefc60000U;
+                y ^= (y >> 18);
+                output[i] = (Real(y) + 0.5)/4294967296.0;
+            }
+            mti += m;
+            output += m;
+            n -= m;
+        }
+    }
+
+    void MersenneTwisterUniformRng::skip(BigNatural n) {
+        if (n <= N-mti) {
+            mti += n;
+            return;
+        }
+        // skip the rest of the current block, then whole blocks
+        n -= N-mti;
+        BigNatural blocks = n/N;
+        // below this, twisting is faster than jumping
+        const BigNatural maxTwists = 10000;
+        if (blocks <= maxTwists) {
+            for (BigNatural i=0; i<blocks; ++i)
+                twist();
+        } else {
+            jump(blocks);
+        }
+        twist();
+        mti = n % N;
+    }
+
+    void MersenneTwisterUniformRng::jump(BigNatural blocks) {
+        static const unsigned long mag01[2]={0x0UL, MATRIX_A};
+        std::vector<char> p = jumpPolynomial(blocks*N);
+
+        /* The state advanced by the given number of steps is p(T)x,
+           where T advances it by one step and x is the current one;
+           it is calculated by Horner's scheme.  The state is stored
+           as a circular buffer whose oldest word is at position k.
+           The words are generated one at a time, as in twist().
+        */
+        std::vector<boost::uint32_t> y(N, 0);
+        Size k = 0;
+        for (Size i=p.size(); i>0; --i) {
+            unsigned long w = (y[k]&UPPER_MASK)|(y[(k+1)%N]&LOWER_MASK);
+            y[k] = y[(k+M)%N] ^ (w >> 1) ^ mag01[w & 0x1UL];
+            k = (k+1)%N;
+            if (p[i-1]) {
+                for (Size j=0; j<N-k; ++j)
+                    y[k+j] ^= mt[j];
+                for (Size j=N-k; j<N; ++j)
+                    y[k+j-N] ^= mt[j];
+            }
+        }
+        // only the most significant bit of the oldest word is
+        // determined by the above; it is the only one used by the
+        // next twist, which the caller must perform.
+        std::rotate_copy(y.begin(), y.begin()+k, y.end(), mt);
+        mti = N;
+    }
+
 }
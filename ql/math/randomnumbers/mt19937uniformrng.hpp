@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -35,8 +36,22 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        Besides returning one number at a time, the generator can
+        fill a buffer with a block of numbers, which avoids a call
+        and a check on the state for each of them, and can skip
+        ahead a given number of draws in logarithmic time by means
+        of the jump-ahead polynomial described in H. Haramoto,
+        M. Matsumoto, T. Nishimura, F. Panneton, P. L'Ecuyer,
+        "Efficient Jump Ahead for F2-Linear Random Number
+        Generators", INFORMS Journal on Computing 20(3), 2008.
+        The latter can be used to divide a single sequence into
+        non-overlapping substreams, e.g., one per thread.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - the numbers returned in blocks and after skipping ahead
+          are checked against those returned one at a time.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,10 +85,17 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! fills the buffer with the next n random integers
+        void nextInt32s(unsigned long* output, Size n) const;
+        //! fills the buffer with the next n random numbers in (0.0, 1.0)
+        void nextReals(Real* output, Size n) const;
+        //! skips the next n draws
+        void skip(BigNatural n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
-        mutable unsigned long mt[N];
+        void jump(BigNatural blocks);
+        mutable boost::uint32_t mt[N];
         mutable Size mti;
         static const unsigned long MATRIX_A, UPPER_MASK, LOWER_MASK;
     };
@@ -27,6 +27,7 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -127,6 +128,30 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        //! fills the buffer with the next n integer points
+        /*! The points are stored one after the other, so that the
+            buffer must have room for n times the dimension.
+        */
+        void nextInt32Sequences(unsigned long* output, Size n) const {
+            for (Size i=0; i<n; ++i, output+=dimensionality_) {
+                const std::vector<unsigned long>& v = nextInt32Sequence();
+                std::copy(v.begin(), v.end(), output);
+            }
+        }
+        //! fills the buffer with the next n points in (0,1)
+        /*! The points are stored as in nextInt32Sequences; the last
+            one is also available through lastSequence().
+        */
+        void nextSequences(Real* output, Size n) const {
+            for (Size i=0; i<n; ++i, output+=dimensionality_) {
+                const std::vector<unsigned long>& v = nextInt32Sequence();
+                for (Size k=0; k<dimensionality_; ++k)
+                    output[k] = v[k] * normalizationFactor_;
+            }
+            if (n > 0)
+                std::copy(output-dimensionality_, output,
+                          sequence_.value.begin());
+        }
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
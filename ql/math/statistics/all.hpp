@@ -7,7 +7,9 @@
 #include <ql/math/statistics/generalstatistics.hpp>
 #include <ql/math/statistics/histogram.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/meanvariancestatistics.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 
@@ -74,6 +74,13 @@ namespace QuantLib {
             for (; begin != end; ++begin, ++wbegin)
                 add(*begin,*wbegin);
         }
+        //! adds the data collected by another instance
+        /*! Since the order of the merged samples is not known, a
+            single entry is added to the convergence table for the
+            merged data if they cross any of the sampling points;
+            further entries are added as more data are collected.
+        */
+        void merge(const ConvergenceStatistics<T,U>& other);
         void reset();
         const std::vector<std::pair<Size,value_type> >& convergenceTable()
                                                                         const;
@@ -112,6 +119,17 @@ namespace QuantLib {
     }
     #endif
 
+    template <class T, class U>
+    void ConvergenceStatistics<T,U>::merge(
+                                    const ConvergenceStatistics<T,U>& other) {
+        T::merge(other);
+        if (this->samples() >= nextSampleSize_) {
+            table_.push_back(std::make_pair(this->samples(),this->mean()));
+            while (nextSampleSize_ <= this->samples())
+                nextSampleSize_ = samplingRule_.nextSamples(nextSampleSize_);
+        }
+    }
+
     template <class T, class U>
     void ConvergenceStatistics<T,U>::reset() {
         T::reset();
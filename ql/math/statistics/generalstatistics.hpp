@@ -27,6 +27,7 @@
 
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 #include <utility>
 
@@ -168,6 +169,10 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        /*! If both sets are sorted, the result is sorted as well. */
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -225,6 +230,18 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        // a copy is needed when merging an instance with itself
+        std::vector<std::pair<Real,Real> > data(other.samples_);
+        bool sorted = sorted_ && other.sorted_;
+        Size n = samples_.size();
+        samples_.insert(samples_.end(), data.begin(), data.end());
+        if (sorted)
+            std::inplace_merge(samples_.begin(), samples_.begin()+n,
+                               samples_.end());
+        sorted_ = sorted;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
@@ -0,0 +1,151 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file meanvariancestatistics.hpp
+    \brief lightweight accumulator for mean and variance
+*/
+
+#ifndef quantlib_mean_variance_statistics_hpp
+#define quantlib_mean_variance_statistics_hpp
+
+#include <ql/errors.hpp>
+#include <ql/types.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Lightweight accumulator for mean and variance
+    /*! This class only stores the number of samples, the sum of
+        their weights, their mean and their second central moment,
+        which are updated as in IncrementalStatistics.  It can be
+        used as the statistics type of Monte Carlo engines that only
+        need the mean and its error estimate, and is small enough to
+        be kept by each thread of a simulation; the accumulators of
+        the threads can then be combined by means of merge().
+
+        \test merging the statistics of two sets of data is checked
+              against adding all the data to a single instance.
+    */
+    class MeanVarianceStatistics {
+      public:
+        typedef Real value_type;
+        MeanVarianceStatistics();
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+        //! weighted mean of the data
+        Real mean() const;
+        /*! returns the variance, defined as in IncrementalStatistics */
+        Real variance() const;
+        //! square root of the variance
+        Real standardDeviation() const;
+        //! square root of the ratio of the variance to the samples
+        Real errorEstimate() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const MeanVarianceStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        void combine(Real weight, Real mean, Real m2);
+        Size samples_;
+        Real weightSum_, mean_, m2_;
+    };
+
+
+    // inline definitions
+
+    inline MeanVarianceStatistics::MeanVarianceStatistics() {
+        reset();
+    }
+
+    inline Real MeanVarianceStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        return mean_;
+    }
+
+    inline Real MeanVarianceStatistics::variance() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        QL_REQUIRE(samples_ > 1, "sample number <= 1, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        return n / (n - 1.0) * m2_ / weightSum_;
+    }
+
+    inline Real MeanVarianceStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real MeanVarianceStatistics::errorEstimate() const {
+        return std::sqrt(variance() / samples_);
+    }
+
+    inline void MeanVarianceStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0,
+                   "negative weight (" << weight << ") not allowed");
+        ++samples_;
+        if (weight > 0.0)
+            combine(weight, value, 0.0);
+    }
+
+    inline void MeanVarianceStatistics::merge(
+                                       const MeanVarianceStatistics& other) {
+        samples_ += other.samples_;
+        if (other.weightSum_ > 0.0)
+            combine(other.weightSum_, other.mean_, other.m2_);
+    }
+
+    inline void MeanVarianceStatistics::combine(Real weight, Real mean,
+                                                Real m2) {
+        const Real total = weightSum_ + weight;
+        const Real delta = mean - mean_, d = delta / total;
+        m2_ += m2 + delta * d * weightSum_ * weight;
+        mean_ += d * weight;
+        weightSum_ = total;
+    }
+
+    inline void MeanVarianceStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = 0.0;
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,230 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Largest quantile that a centroid starting at quantile q can
+           reach, i.e., k^{-1}(k(q)+1) for the scale function
+           k(q) = delta/(2 pi) asin(2q-1).
+        */
+        Real maxQuantile(Real q, Real delta) {
+            Real x = std::max(-1.0, std::min(2.0*q-1.0, 1.0));
+            Real k = delta/(2.0*M_PI) * std::asin(x) + 1.0;
+            if (k >= 0.25*delta)
+                return 1.0;
+            return 0.5*(std::sin(2.0*M_PI*k/delta) + 1.0);
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Real compression,
+                                             Size tailSize)
+    : compression_(compression), tailSize_(tailSize) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_
+                   << ") must be at least 10");
+        buffer_.reserve(Size(5*compression_));
+    }
+
+    Size StreamingStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        Real sampleWeight = weightSum();
+        QL_REQUIRE(sampleWeight>0.0,
+                   "empty sample set");
+        Real target = percent*sampleWeight;
+
+        if (!tail_.empty()) {
+            Real tailWeight = 0.0;
+            for (Size i=0; i<tail_.size(); ++i)
+                tailWeight += tail_[i].second;
+            if (tailIsComplete() || tailWeight >= target) {
+                // the same search performed by GeneralStatistics
+                std::vector<std::pair<Real,Real> > data(tail_);
+                std::sort(data.begin(), data.end());
+                std::vector<std::pair<Real,Real> >::const_iterator k, l;
+                k = data.begin();
+                l = data.end()-1;
+                Real integral = k->second;
+                while (integral < target && k != l) {
+                    ++k;
+                    integral += k->second;
+                }
+                return k->first;
+            }
+        }
+
+        return quantile(target);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        Real sampleWeight = weightSum();
+        QL_REQUIRE(sampleWeight > 0.0,
+                   "empty sample set");
+        Real target = percent*sampleWeight;
+
+        if (!tail_.empty() && tailIsComplete()) {
+            std::vector<std::pair<Real,Real> > data(tail_);
+            std::sort(data.begin(), data.end());
+            std::vector<std::pair<Real,Real> >::const_reverse_iterator k, l;
+            k = data.rbegin();
+            l = data.rend()-1;
+            Real integral = k->second;
+            while (integral < target && k != l) {
+                ++k;
+                integral += k->second;
+            }
+            return k->first;
+        }
+
+        return quantile(sampleWeight - target);
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0,
+                   "negative weight (" << weight << ") not allowed");
+        moments_.add(value, weight);
+        if (tailSize_ > 0)
+            addToTail(value, weight);
+        // null weights don't contribute to the distribution
+        if (weight > 0.0) {
+            buffer_.push_back(Centroid(value, weight, 1));
+            if (buffer_.size() >= Size(5*compression_))
+                compress();
+        }
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        QL_REQUIRE(tailSize_ == other.tailSize_,
+                   "different tail sizes (" << tailSize_ << ", "
+                   << other.tailSize_ << ")");
+        // copies are needed when merging an instance with itself
+        std::vector<Centroid> centroids(other.centroids_);
+        centroids.insert(centroids.end(),
+                         other.buffer_.begin(), other.buffer_.end());
+        std::vector<std::pair<Real,Real> > tail(other.tail_);
+
+        moments_.merge(other.moments_);
+        for (Size i=0; i<tail.size(); ++i)
+            addToTail(tail[i].first, tail[i].second);
+        buffer_.insert(buffer_.end(), centroids.begin(), centroids.end());
+        compress();
+    }
+
+    void StreamingStatistics::reset() {
+        moments_.reset();
+        centroids_.clear();
+        buffer_.clear();
+        tail_.clear();
+    }
+
+    void StreamingStatistics::addToTail(Real value, Real weight) {
+        std::pair<Real,Real> datum(value, weight);
+        if (tail_.size() < tailSize_) {
+            tail_.push_back(datum);
+            std::push_heap(tail_.begin(), tail_.end());
+        } else if (datum < tail_.front()) {
+            std::pop_heap(tail_.begin(), tail_.end());
+            tail_.back() = datum;
+            std::push_heap(tail_.begin(), tail_.end());
+        }
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+        Real total = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            total += buffer_[i].weight;
+
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        // weight of the centroids already added to the digest
+        Real before = 0.0;
+        Real limit = total*maxQuantile(0.0, compression_);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& c = buffer_[i];
+            if (before + current.weight + c.weight <= limit) {
+                current.weight += c.weight;
+                current.mean +=
+                    (c.mean - current.mean) * c.weight/current.weight;
+                current.samples += c.samples;
+            } else {
+                before += current.weight;
+                centroids_.push_back(current);
+                limit = total*maxQuantile(before/total, compression_);
+                current = c;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    Real StreamingStatistics::quantile(Real target) const {
+        compress();
+        QL_REQUIRE(!centroids_.empty(), "empty sample set");
+
+        const Centroid& first = centroids_.front();
+        if (target <= 0.5*first.weight) {
+            if (first.samples == 1)
+                return first.mean;
+            Real lo = min();
+            return lo + (first.mean - lo) * target/(0.5*first.weight);
+        }
+
+        // cumulative weight at the center of the current centroid
+        Real center = 0.5*first.weight;
+        for (Size i=1; i<centroids_.size(); ++i) {
+            const Centroid& left = centroids_[i-1];
+            const Centroid& right = centroids_[i];
+            Real next = center + 0.5*(left.weight + right.weight);
+            if (target <= next) {
+                return left.mean + (right.mean - left.mean)
+                                   * (target - center)/(next - center);
+            }
+            center = next;
+        }
+
+        const Centroid& last = centroids_.back();
+        if (last.samples == 1)
+            return last.mean;
+        Real hi = max();
+        Real remaining = std::min(target - center, 0.5*last.weight);
+        return last.mean + (hi - last.mean) * remaining/(0.5*last.weight);
+    }
+
+}
@@ -0,0 +1,227 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory based on a t-digest
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class returns the same statistics as GeneralStatistics
+        without storing all the samples.  Mean, variance and higher
+        moments are accumulated as in IncrementalStatistics; the
+        empirical distribution is summarized by a merging t-digest
+        (T. Dunning and O. Ertl, "Computing extremely accurate
+        quantiles using t-digests", 2019) made of at most
+        \f$ \delta \f$ weighted centroids, \f$ \delta \f$ being the
+        given compression.  Percentiles are interpolated between the
+        centroids, and expectation values are calculated by treating
+        each centroid as a point mass at its mean.
+
+        With the scale function used here, a centroid at quantile
+        \f$ q \f$ holds at most a fraction
+        \f$ 2\pi\sqrt{q(1-q)}/\delta \f$ of the total weight; this
+        bounds the error on the rank of the returned percentiles,
+        which is therefore smaller in the tails.
+
+        If a positive tail size \f$ k \f$ is given, the \f$ k \f$
+        lowest samples (i.e., the worst losses) are also kept
+        exactly.  Percentiles falling among them are then the same
+        returned by GeneralStatistics, and expectation values on
+        ranges below the largest of them (such as those needed for
+        the expected shortfall) are calculated exactly from the
+        retained samples.
+
+        The data collected by two instances can be combined by means
+        of the merge() method.
+
+        \test percentiles, value-at-risk and expected shortfall are
+              checked against those returned by GeneralStatistics and
+              RiskStatistics, also after merging.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Real compression = 200.0,
+                                     Size tailSize = 0);
+        //! \name Inspectors
+        //@{
+        Real compression() const { return compression_; }
+        Size tailSize() const { return tailSize_; }
+        //! number of samples collected
+        Size samples() const { return moments_.samples(); }
+        //! sum of data weights
+        Real weightSum() const { return moments_.weightSum(); }
+        //! weighted mean of the data
+        Real mean() const { return moments_.mean(); }
+        //! variance, defined as in GeneralStatistics
+        Real variance() const { return moments_.variance(); }
+        //! square root of the variance
+        Real standardDeviation() const {
+            return moments_.standardDeviation();
+        }
+        //! error estimate on the mean value
+        Real errorEstimate() const { return moments_.errorEstimate(); }
+        //! skewness, defined as in GeneralStatistics
+        Real skewness() const { return moments_.skewness(); }
+        //! excess kurtosis, defined as in GeneralStatistics
+        Real kurtosis() const { return moments_.kurtosis(); }
+        //! minimum sample value
+        Real min() const { return moments_.min(); }
+        //! maximum sample value
+        Real max() const { return moments_.max(); }
+        //! number of centroids currently used by the digest
+        Size centroids() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, as in GeneralStatistics.  The
+            retained tail samples are used exactly; the rest of the
+            data are represented by the centroids of the digest.
+
+            The function returns a pair made of the result and the
+            number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const;
+
+        /*! \f$ y \f$-th percentile, as in GeneralStatistics.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile, as in GeneralStatistics.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        /*! \pre the two instances must have the same tail size */
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid(Real mean, Real weight, Size samples)
+            : mean(mean), weight(weight), samples(samples) {}
+            Real mean, weight;
+            Size samples;
+            bool operator<(const Centroid& c) const {
+                return mean < c.mean;
+            }
+        };
+        // merges the buffered centroids into the digest
+        void compress() const;
+        void addToTail(Real value, Real weight);
+        // whether the retained tail contains all the samples
+        bool tailIsComplete() const {
+            return tail_.size() == moments_.samples();
+        }
+        // value with the given cumulative weight, interpolated
+        // between the centroids of the digest
+        Real quantile(Real weight) const;
+        IncrementalStatistics moments_;
+        Real compression_;
+        Size tailSize_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+        // max-heap of the lowest samples and their weights
+        std::vector<std::pair<Real,Real> > tail_;
+    };
+
+    //! risk measures based on streaming statistics
+    /*! \test the value-at-risk and expected shortfall are checked
+              against those returned by RiskStatistics.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                       StreamingStatistics> >
+                                                    StreamingRiskStatistics;
+
+
+    // template definitions
+
+    template <class Func, class Predicate>
+    std::pair<Real,Size> StreamingStatistics::expectationValue(
+                                     const Func& f,
+                                     const Predicate& inRange) const {
+        Real num = 0.0, den = 0.0;
+        Size N = 0;
+        for (Size i=0; i<tail_.size(); ++i) {
+            Real x = tail_[i].first, w = tail_[i].second;
+            if (inRange(x)) {
+                num += f(x)*w;
+                den += w;
+                N += 1;
+            }
+        }
+        if (!tailIsComplete()) {
+            // centroids below the largest retained sample are
+            // already accounted for by the tail
+            bool skipTail = !tail_.empty();
+            Real threshold = skipTail ? tail_.front().first : 0.0;
+            compress();
+            for (Size i=0; i<centroids_.size(); ++i) {
+                const Centroid& c = centroids_[i];
+                if (skipTail && c.mean <= threshold)
+                    continue;
+                if (inRange(c.mean)) {
+                    num += f(c.mean)*c.weight;
+                    den += c.weight;
+                    N += c.samples;
+                }
+            }
+        }
+        if (N == 0)
+            return std::make_pair<Real,Size>(Null<Real>(),0);
+        else
+            return std::make_pair(num/den,N);
+    }
+
+}
+
+
+#endif
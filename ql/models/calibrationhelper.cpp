@@ -84,4 +84,57 @@ namespace QuantLib {
         
         return error;
     }
+
+    Real CalibrationHelper::modelValueAndGradient(Array&) const {
+        QL_FAIL("analytic gradient not available");
+    }
+
+    Real CalibrationHelper::calibrationErrorAndGradient(Array& gradient) {
+        Real error;
+        const Real modelPrice = modelValueAndGradient(gradient);
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            {
+              const Real diff = marketValue() - modelPrice;
+              error = std::fabs(diff)/marketValue();
+              gradient *= (diff > 0.0 ? -1.0 : 1.0)/marketValue();
+            }
+            break;
+          case PriceError:
+            error = marketValue() - modelPrice;
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real lowerPrice = blackPrice(minVol);
+              const Real upperPrice = blackPrice(maxVol);
+
+              Volatility implied;
+              if (modelPrice <= lowerPrice) {
+                  implied = minVol;
+                  std::fill(gradient.begin(), gradient.end(), 0.0);
+              } else if (modelPrice >= upperPrice) {
+                  implied = maxVol;
+                  std::fill(gradient.begin(), gradient.end(), 0.0);
+              } else {
+                  implied = this->impliedVolatility(
+                                          modelPrice, 1e-12, 5000, minVol, maxVol);
+                  // d(implied)/d(price) is the inverse of the vega
+                  const Real h = std::min(1e-6, 0.5*(implied - minVol));
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2.0*h);
+                  gradient /= vega;
+              }
+              error = implied - volatility_->value();
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return error;
+    }
 }
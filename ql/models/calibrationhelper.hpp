@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
 #include <list>
 
 namespace QuantLib {
@@ -72,6 +73,22 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! whether the model value gradient is available analytically
+        virtual bool hasAnalyticGradient() const { return false; }
+
+        //! returns the model value and its gradient
+        /*! The gradient is taken with respect to the model
+            parameters, in the order given by
+            CalibratedModel::params().
+        */
+        virtual Real modelValueAndGradient(Array& gradient) const;
+
+        //! returns the calibration error and its gradient
+        /*! The gradient is taken with respect to the model
+            parameters; it requires hasAnalyticGradient() to be true.
+        */
+        virtual Real calibrationErrorAndGradient(Array& gradient);
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -88,6 +105,11 @@ namespace QuantLib {
             engine_ = engine;
         }
 
+        //! returns the engine used for the model value
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
+
       protected:
         mutable Real marketValue_;
         Handle<Quote> volatility_;
@@ -20,6 +20,7 @@
 */
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
@@ -84,6 +85,21 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::hasAnalyticGradient() const {
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        return engine && engine->hasAnalyticGradient();
+    }
+
+    Real HestonModelHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        QL_REQUIRE(engine, "analytic gradient requires analytic Heston engine");
+        gradient = engine->gradient(strikePrice_, exerciseDate_);
+        return modelValue();
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
@@ -57,6 +57,10 @@ namespace QuantLib {
         void performCalculations() const;
         Real modelValue() const;
         Real blackPrice(Real volatility) const;
+        /*! \note the gradient is available when pricing with the
+                  analytic Heston engine */
+        bool hasAnalyticGradient() const;
+        Real modelValueAndGradient(Array& gradient) const;
         Time maturity() const  { calculate(); return tau_; }
       private:
         const Period maturity_;
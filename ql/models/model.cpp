@@ -24,6 +24,8 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <boost/make_shared.hpp>
+#include <set>
 
 using std::vector;
 using boost::shared_ptr;
@@ -42,26 +44,90 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) { }
+              weights_(weights), projection_(projection),
+              analyticGradient_(!h.empty()), parallelRepricing_(true) {
+            for (Size i=0; i<instruments_.size(); i++)
+                analyticGradient_ = analyticGradient_ &&
+                                    instruments_[i]->hasAnalyticGradient();
+#ifdef QL_ENABLE_PARALLEL_CALIBRATION
+            // helpers sharing an engine would write concurrently to
+            // its arguments and results; they are repriced serially
+            std::set<const PricingEngine*> engines;
+            for (Size i=0; i<instruments_.size(); i++) {
+                if (!engines.insert(
+                           instruments_[i]->pricingEngine().get()).second)
+                    parallelRepricing_ = false;
+            }
+#endif
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors(params);
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
+                value += errors[i]*errors[i]*weights_[i];
             }
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
-            model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors(params);
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
+            }
+            return values;
+        }
+
+        virtual void gradient(Array& grad, const Array& params) const {
+            if (analyticGradient_)
+                valueAndGradient(grad, params);
+            else
+                CostFunction::gradient(grad, params);
+        }
+
+        virtual Real valueAndGradient(Array& grad,
+                                      const Array& params) const {
+            if (!analyticGradient_)
+                return CostFunction::valueAndGradient(grad, params);
+            Matrix errorGradients;
+            Array errors = calibrationErrors(params, &errorGradients);
+            Real value = 0.0;
+            Array g(errorGradients.columns(), 0.0);
+            for (Size i=0; i<instruments_.size(); i++) {
+                value += errors[i]*errors[i]*weights_[i];
+                for (Size j=0; j<g.size(); j++)
+                    g[j] += errors[i]*weights_[i]*errorGradients[i][j];
+            }
+            value = std::sqrt(value);
+            if (value > 0.0)
+                g /= value;
+            grad = projection_.project(g);
+            return value;
+        }
+
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            if (analyticGradient_)
+                valuesAndJacobian(jac, params);
+            else
+                CostFunction::jacobian(jac, params);
+        }
+
+        virtual Disposable<Array> valuesAndJacobian(
+                                 Matrix& jac, const Array& params) const {
+            if (!analyticGradient_)
+                return CostFunction::valuesAndJacobian(jac, params);
+            Matrix errorGradients;
+            Array values = calibrationErrors(params, &errorGradients);
+            Array g(errorGradients.columns());
+            for (Size i=0; i<instruments_.size(); i++) {
+                Real w = std::sqrt(weights_[i]);
+                values[i] *= w;
+                for (Size j=0; j<g.size(); j++)
+                    g[j] = errorGradients[i][j]*w;
+                Array p = projection_.project(g);
+                std::copy(p.begin(), p.end(), jac.row_begin(i));
             }
             return values;
         }
@@ -69,10 +135,66 @@ namespace QuantLib {
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        /* if gradients is given, row i is filled with the gradient
+           of the i-th error w.r.t. the full set of model parameters */
+        Disposable<Array> calibrationErrors(const Array& params,
+                                            Matrix* gradients = 0) const {
+            model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            if (gradients)
+                *gradients = Matrix(instruments_.size(),
+                                    model_->params().size());
+#ifdef QL_ENABLE_PARALLEL_CALIBRATION
+            // helpers are lazy objects and the term structures they
+            // refer to are usually lazy as well; we trigger these
+            // calculations here so that the parallel loop below only
+            // reprices the helpers against the (read only) model.
+            for (Size i=0; i<instruments_.size(); i++)
+                instruments_[i]->marketValue();
+            // exceptions can't leave the parallel region; they are
+            // stored and the first one is rethrown afterwards
+            vector<shared_ptr<Error> > failures(instruments_.size());
+#pragma omp parallel for default(shared) if(parallelRepricing_)
+            for (long i=0; i<static_cast<long>(instruments_.size()); i++) {
+                try {
+                    errors[i] = calibrationError(i, gradients);
+                } catch (Error& e) {
+                    failures[i] = boost::make_shared<Error>(e);
+                } catch (std::exception& e) {
+                    failures[i] = boost::make_shared<Error>(
+                                 __FILE__, __LINE__, BOOST_CURRENT_FUNCTION,
+                                 e.what());
+                } catch (...) {
+                    failures[i] = boost::make_shared<Error>(
+                                 __FILE__, __LINE__, BOOST_CURRENT_FUNCTION,
+                                 "unknown error");
+                }
+            }
+            for (Size i=0; i<instruments_.size(); i++) {
+                if (failures[i])
+                    throw *failures[i];
+            }
+#else
+            for (Size i=0; i<instruments_.size(); i++)
+                errors[i] = calibrationError(i, gradients);
+#endif
+            return errors;
+        }
+
+        Real calibrationError(Size i, Matrix* gradients) const {
+            if (!gradients)
+                return instruments_[i]->calibrationError();
+            Array g(gradients->columns());
+            Real error = instruments_[i]->calibrationErrorAndGradient(g);
+            std::copy(g.begin(), g.end(), gradients->row_begin(i));
+            return error;
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        bool analyticGradient_, parallelRepricing_;
     };
 
     void CalibratedModel::calibrate(
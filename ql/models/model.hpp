@@ -95,6 +95,22 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            \note If QL_ENABLE_PARALLEL_CALIBRATION is defined and
+                  the library is compiled with OpenMP, the helpers
+                  are repriced concurrently for each evaluation of
+                  the cost function, unless two of them share a
+                  pricing engine instance. The model must then be
+                  safe to read from several threads;
+                  models caching results from const methods (e.g.,
+                  the Gaussian1dModel classes) are not.
+
+            \note If all helpers provide an analytic gradient (see
+                  CalibrationHelper::hasAnalyticGradient()) the cost
+                  function uses it for its gradient and jacobian
+                  instead of finite differences. Notice that the
+                  Levenberg-Marquardt method only uses the jacobian
+                  of the cost function if it is told to do so.
         */
         virtual void calibrate(
                 const std::vector<boost::shared_ptr<CalibrationHelper> >&,
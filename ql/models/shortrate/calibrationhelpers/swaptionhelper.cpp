@@ -22,6 +22,7 @@
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/blackswaptionengine.hpp>
 #include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -113,6 +114,23 @@ namespace QuantLib {
         return swaption_->NPV();
     }
 
+    bool SwaptionHelper::hasAnalyticGradient() const {
+        boost::shared_ptr<JamshidianSwaptionEngine> engine =
+            boost::dynamic_pointer_cast<JamshidianSwaptionEngine>(engine_);
+        return engine && engine->hasAnalyticGradient();
+    }
+
+    Real SwaptionHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        boost::shared_ptr<JamshidianSwaptionEngine> engine =
+            boost::dynamic_pointer_cast<JamshidianSwaptionEngine>(engine_);
+        QL_REQUIRE(engine, "analytic gradient requires Jamshidian engine");
+        Swaption::arguments args;
+        swaption_->setupArguments(&args);
+        args.validate();
+        return engine->valueAndGradient(args, gradient);
+    }
+
     Real SwaptionHelper::blackPrice(Volatility sigma) const {
         calculate();
         Handle<Quote> vol(boost::shared_ptr<Quote>(new SimpleQuote(sigma)));
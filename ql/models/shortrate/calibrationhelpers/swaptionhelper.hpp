@@ -84,6 +84,11 @@ namespace QuantLib {
         virtual Real modelValue() const;
         virtual Real blackPrice(Volatility volatility) const;
 
+        /*! \note the gradient is available when pricing with the
+                  Jamshidian engine and the Hull-White model */
+        virtual bool hasAnalyticGradient() const;
+        virtual Real modelValueAndGradient(Array& gradient) const;
+
         boost::shared_ptr<VanillaSwap> underlyingSwap() const { calculate(); return swap_; }
         boost::shared_ptr<Swaption> swaption() const { calculate(); return swaption_; }
 
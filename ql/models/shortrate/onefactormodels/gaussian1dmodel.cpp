@@ -25,6 +25,50 @@ using std::exp;
 
 namespace QuantLib {
 
+namespace {
+
+    // integrates the monotonic cubic spline interpolating the payoff
+    // values at the conditional grid yg against the Gaussian density
+    // using precomputed weights, p is used as workspace
+    Real gaussianSplineIntegral(const CubicInterpolation &payoff,
+                                Matrix::const_row_iterator yg,
+                                const Array &z, const Matrix &w, Array &p,
+                                const bool extrapolatePayoff,
+                                const bool flatPayoffExtrapolation,
+                                const Option::Type type) {
+        const Size n = z.size();
+        for (Size i = 0; i < n; i++) {
+            p[i] = payoff(yg[i], true);
+        }
+        CubicInterpolation payoff1(
+            z.begin(), z.end(), p.begin(), CubicInterpolation::Spline, true,
+            CubicInterpolation::Lagrange, 0.0, CubicInterpolation::Lagrange,
+            0.0);
+        const std::vector<Real> &a = payoff1.aCoefficients();
+        const std::vector<Real> &b = payoff1.bCoefficients();
+        const std::vector<Real> &c = payoff1.cCoefficients();
+        Real price = 0.0;
+        for (Size i = 0; i < n - 1; i++) {
+            price += w[i][0] * p[i] + w[i][1] * a[i] + w[i][2] * b[i] +
+                     w[i][3] * c[i];
+        }
+        if (extrapolatePayoff) {
+            if (flatPayoffExtrapolation) {
+                price += w[n][0] * p[n - 2] + w[n - 1][0] * p[0];
+            } else {
+                if (type == Option::Call)
+                    price += w[n][0] * p[n - 2] + w[n][1] * a[n - 2] +
+                             w[n][2] * b[n - 2] + w[n][3] * c[n - 2];
+                if (type == Option::Put)
+                    price += w[n - 1][0] * p[0] + w[n - 1][1] * a[0] +
+                             w[n - 1][2] * b[0] + w[n - 1][3] * c[0];
+            }
+        }
+        return price;
+    }
+
+}
+
 Real Gaussian1dModel::forwardRate(const Date &fixing,
                                   const Date &referenceDate, const Real y,
                                   boost::shared_ptr<IborIndex> iborIdx) const {
@@ -282,4 +326,98 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     return result;
 }
+
+const Matrix &Gaussian1dModel::conditionalGrids(const Real yStdDevs,
+                                                const int gridPoints,
+                                                const Time T,
+                                                const Time t) const {
+
+    CachedGridKey k = {yStdDevs, gridPoints, T, t};
+    GridCacheType::iterator i = conditionalGridCache_.find(k);
+    if (i != conditionalGridCache_.end())
+        return i->second;
+
+    Array z = yGrid(yStdDevs, gridPoints);
+    Matrix grids(z.size(), z.size());
+    for (Size j = 0; j < z.size(); j++) {
+        Array yg = yGrid(yStdDevs, gridPoints, T, t, z[j]);
+        std::copy(yg.begin(), yg.end(), grids.row_begin(j));
+    }
+    if (conditionalGridCache_.size() >= maxCachedGrids)
+        conditionalGridCache_.clear();
+    return conditionalGridCache_.insert(std::make_pair(k, grids))
+        .first->second;
+}
+
+const Matrix &Gaussian1dModel::integrationWeights(const Real yStdDevs,
+                                                  const int gridPoints) const {
+
+    CachedGridKey k = {yStdDevs, gridPoints, 0.0, 0.0};
+    GridCacheType::iterator i = integrationWeightsCache_.find(k);
+    if (i != integrationWeightsCache_.end())
+        return i->second;
+
+    Array z = yGrid(yStdDevs, gridPoints);
+    const Size n = z.size();
+    Matrix w(n + 1, 4);
+    for (Size j = 0; j < 4; j++) {
+        const Real e = j == 0 ? 1.0 : 0.0, d = j == 1 ? 1.0 : 0.0,
+                   c = j == 2 ? 1.0 : 0.0, b = j == 3 ? 1.0 : 0.0;
+        for (Size i = 0; i < n - 1; i++) {
+            w[i][j] = gaussianShiftedPolynomialIntegral(0.0, b, c, d, e, z[i],
+                                                        z[i], z[i + 1]);
+        }
+        w[n - 1][j] = gaussianShiftedPolynomialIntegral(0.0, b, c, d, e, z[0],
+                                                        -100.0, z[0]);
+        w[n][j] = gaussianShiftedPolynomialIntegral(
+            0.0, b, c, d, e, z[n - 2], z[n - 1], 100.0);
+    }
+    if (integrationWeightsCache_.size() >= maxCachedGrids)
+        integrationWeightsCache_.clear();
+    return integrationWeightsCache_.insert(std::make_pair(k, w)).first->second;
+}
+
+void Gaussian1dModel::rollback(Array &result, const Array &values,
+                               const Time T, const Time t,
+                               const Real yStdDevs, const int gridPoints,
+                               const bool extrapolatePayoff,
+                               const bool flatPayoffExtrapolation,
+                               const Option::Type type, const Real y) const {
+
+    calculate();
+
+    const Size n = 2 * gridPoints + 1;
+    QL_REQUIRE(values.size() == n, "values size (" << values.size()
+                                                   << ") must be equal to "
+                                                   << "grid size (" << n
+                                                   << ")");
+    QL_REQUIRE(result.size() >= (y == Null<Real>() ? n : 1),
+               "result size (" << result.size() << ") too small");
+
+    Array z = yGrid(yStdDevs, gridPoints);
+    const Matrix &w = integrationWeights(yStdDevs, gridPoints);
+    Array p(n, 0.0);
+
+    CubicInterpolation payoff(
+        z.begin(), z.end(), values.begin(), CubicInterpolation::Spline, true,
+        CubicInterpolation::Lagrange, 0.0, CubicInterpolation::Lagrange, 0.0);
+
+    if (y != Null<Real>()) {
+        Array yg = yGrid(yStdDevs, gridPoints, T, t, y);
+        result[0] = gaussianSplineIntegral(payoff, yg.begin(), z, w, p,
+                                           extrapolatePayoff,
+                                           flatPayoffExtrapolation, type);
+        return;
+    }
+
+    // the cache is filled here, outside the parallelized loop below
+    const Matrix &grids = conditionalGrids(yStdDevs, gridPoints, T, t);
+
+#pragma omp parallel for default(shared) firstprivate(p)
+    for (long k = 0; k < static_cast<long>(n); k++) {
+        result[k] = gaussianSplineIntegral(payoff, grids.row_begin(k), z, w, p,
+                                           extrapolatePayoff,
+                                           flatPayoffExtrapolation, type);
+    }
+}
 }
@@ -29,6 +29,7 @@
 
 #include <ql/models/model.hpp>
 #include <ql/models/parameter.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/instruments/vanillaswap.hpp>
@@ -71,6 +72,11 @@ namespace QuantLib {
     \warning the variance of the state process conditional on
     $x(t)=x$ must be independent of the value of $x$
 
+    \warning the underlying swaps and the rollback grids are cached
+    in the model without synchronization, so concurrent pricings
+    against the same model instance are not supported (this includes
+    the parallel calibration enabled by QL_ENABLE_PARALLEL_CALIBRATION)
+
 */
 
 class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
@@ -148,6 +154,27 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                                   const Real T = 1.0, const Real t = 0,
                                   const Real y = 0) const;
 
+    /*! Computes the conditional expectations
+        \f[ E( v(y(T)) | y(t)=z_k ) \f]
+        of a (deflated) payoff given by its values $v$ on the grid
+        yGrid(yStdDevs, gridPoints) for all points $z_k$ of the same grid
+        and stores them in result. If y is given, only the expectation
+        conditional on $y(t)=y$ is computed and stored in result[0].
+
+        The payoff is interpolated by a monotonic cubic spline and
+        integrated exactly against the Gaussian density. The conditional
+        grids are cached per time pair and the integration weights per
+        grid, so that rolling back several payoffs between the same
+        times (e.g. for several swaptions sharing exercise dates) only
+        costs a spline construction and a weighted sum per grid point.
+    */
+    void rollback(Array &result, const Array &values, const Time T,
+                  const Time t, const Real yStdDevs, const int gridPoints,
+                  const bool extrapolatePayoff = true,
+                  const bool flatPayoffExtrapolation = false,
+                  const Option::Type type = Option::Call,
+                  const Real y = Null<Real>()) const;
+
   private:
     // It is of great importance for performance reasons to cache underlying
     // swaps generated from indexes. In addition the indexes may only be given
@@ -181,6 +208,51 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // The conditional grids used in the rollback depend on the model
+    // parameters and are cached per time pair, the weights for the
+    // integration of cubic polynomials against the Gaussian density
+    // only depend on the grid. Both caches are cleared when they reach
+    // maxCachedGrids entries, so that their size stays bounded when
+    // many different times or grids are used with the same model.
+
+    struct CachedGridKey {
+        const Real yStdDevs;
+        const int gridPoints;
+        const Time T, t;
+        bool operator==(const CachedGridKey &o) const {
+            return yStdDevs == o.yStdDevs && gridPoints == o.gridPoints &&
+                   T == o.T && t == o.t;
+        }
+    };
+
+    struct CachedGridKeyHasher
+        : std::unary_function<CachedGridKey, std::size_t> {
+        std::size_t operator()(CachedGridKey const &x) const {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, x.yStdDevs);
+            boost::hash_combine(seed, x.gridPoints);
+            boost::hash_combine(seed, x.T);
+            boost::hash_combine(seed, x.t);
+            return seed;
+        }
+    };
+
+    typedef boost::unordered_map<CachedGridKey, Matrix, CachedGridKeyHasher>
+        GridCacheType;
+
+    mutable GridCacheType conditionalGridCache_, integrationWeightsCache_;
+    static const Size maxCachedGrids = 64;
+
+    // row k holds yGrid(yStdDevs, gridPoints, T, t, z_k)
+    const Matrix &conditionalGrids(const Real yStdDevs, const int gridPoints,
+                                   const Time T, const Time t) const;
+
+    // rows 0 ... 2*gridPoints-1 hold the weights for the integral of
+    // (x-z_i)^j, j=0,1,2,3 on [z_i,z_{i+1}], the last two rows the ones
+    // used for the extrapolation to the left and to the right
+    const Matrix &integrationWeights(const Real yStdDevs,
+                                     const int gridPoints) const;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -201,13 +273,19 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        flushConditionalGrids();
     }
 
     void generateArguments() {
         calculate();
+        flushConditionalGrids();
         notifyObservers();
     }
 
+    // must be called by derived classes whenever the state process
+    // changes without triggering performCalculations()
+    void flushConditionalGrids() const { conditionalGridCache_.clear(); }
+
     // retrieve underlying swap from cache if possible, otherwise
     // create it and store it in the cache
     boost::shared_ptr<VanillaSwap>
@@ -95,6 +95,7 @@ Gsr::Gsr(const Handle<YieldTermStructure> &termStructure,
 void Gsr::update() { 
 	if (stateProcess_ != NULL)
         boost::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
+    flushConditionalGrids();
 	LazyObject::update();
 }
 
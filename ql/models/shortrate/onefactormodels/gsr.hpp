@@ -30,6 +30,14 @@
 namespace QuantLib {
 
 //! One factor gsr model, formulation is in forward measure
+/*! \warning The model and its state process cache intermediate
+             results without synchronization. When the library is
+             compiled with QL_ENABLE_PARALLEL_CALIBRATION, the
+             helpers of a calibration are repriced concurrently
+             against the same model, so Gsr must not be calibrated
+             in that configuration. Separate instances can be used
+             from different threads.
+*/
 
 class Gsr : public Gaussian1dModel, public CalibratedModel {
 
@@ -141,6 +149,7 @@ class Gsr : public Gaussian1dModel, public CalibratedModel {
 
     void generateArguments() {
         boost::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
+        flushConditionalGrids();
         notifyObservers();
     }
 
@@ -124,6 +124,45 @@ namespace QuantLib {
         return blackFormula(type, k, f, v);
     }
 
+    Disposable<Array> HullWhite::discountBondOptionGradient(
+                                       Option::Type, Real strike,
+                                       Time maturity, Time bondStart,
+                                       Time bondMaturity) const {
+
+        // the forward and the strike do not depend on the parameters,
+        // so we only need the derivatives of the volatility v = sigma*w
+        Real _a = a();
+        Real w, dwda;
+        if (_a < std::sqrt(QL_EPSILON)) {
+            Real tau = bondMaturity - bondStart;
+            w = B(bondStart, bondMaturity)*std::sqrt(maturity);
+            dwda = -0.5*tau*tau*std::sqrt(maturity);
+        } else {
+            Real e = exp(-2.0*_a*(bondStart-maturity))-exp(-2.0*_a*bondStart)
+                -2.0*(exp(-_a*(bondStart+bondMaturity-2.0*maturity))-exp(-_a*(bondStart+bondMaturity)))
+                +exp(-2.0*_a*(bondMaturity-maturity))-exp(-2.0*_a*bondMaturity);
+            Real de = -2.0*(bondStart-maturity)*exp(-2.0*_a*(bondStart-maturity))
+                +2.0*bondStart*exp(-2.0*_a*bondStart)
+                +2.0*((bondStart+bondMaturity-2.0*maturity)*exp(-_a*(bondStart+bondMaturity-2.0*maturity))
+                      -(bondStart+bondMaturity)*exp(-_a*(bondStart+bondMaturity)))
+                -2.0*(bondMaturity-maturity)*exp(-2.0*_a*(bondMaturity-maturity))
+                +2.0*bondMaturity*exp(-2.0*_a*bondMaturity);
+            w = sqrt(std::max(e, 0.0))/(_a*sqrt(2.0*_a));
+            dwda = w > 0.0 ? w*(0.5*de/e - 1.5/_a) : 0.0;
+        }
+        Real _sigma = sigma(), v = _sigma*w;
+        Real f = termStructure()->discount(bondMaturity);
+        Real k = termStructure()->discount(bondStart)*strike;
+
+        // the vega does not depend on the option type
+        Real vega = blackFormulaStdDevDerivative(k, f, v);
+
+        Array gradient(2);
+        gradient[0] = vega*_sigma*dwda;
+        gradient[1] = vega*w;
+        return gradient;
+    }
+
     Rate HullWhite::convexityBias(Real futuresPrice,
                                   Time t,
                                   Time T,
@@ -65,6 +65,13 @@ namespace QuantLib {
                                Time bondStart,
                                Time bondMaturity) const;
 
+        //! derivatives of discountBondOption w.r.t. a and sigma
+        Disposable<Array> discountBondOptionGradient(Option::Type type,
+                                                     Real strike,
+                                                     Time maturity,
+                                                     Time bondStart,
+                                                     Time bondMaturity) const;
+
         /*! Futures convexity bias (i.e., the difference between
             futures implied rate and forward rate) calculated as in
             G. Kirikos, D. Novak, "Convexity Conundrums", Risk
@@ -450,14 +450,43 @@ namespace QuantLib {
         QL_MFMESSAGE(modelOutputs_, "updating numeraire tabulation");
         modelOutputs_.dirty_ = true;
 
-        modelOutputs_.adjustmentFactors_.clear();
-        modelOutputs_.digitalsAdjustmentFactors_.clear();
+        // with incremental tabulation the latest points are kept as long
+        // as neither the global inputs nor their own inputs changed
+        bool incremental = (modelSettings_.adjustments_ &
+                            ModelSettings::IncrementalTabulation) != 0;
+        std::vector<Real> globalInputs;
+        if (incremental)
+            globalInputs = tabulationInputs();
+        bool keep = incremental && !tabulationInputs_.empty() &&
+                    globalInputs == tabulationInputs_;
+        tabulationInputs_.clear();
+
+        if (!keep) {
+            modelOutputs_.adjustmentFactors_.clear();
+            modelOutputs_.digitalsAdjustmentFactors_.clear();
+        }
+        modelOutputs_.adjustmentFactors_.resize(calibrationPoints_.size(),
+                                                1.0);
+        modelOutputs_.digitalsAdjustmentFactors_.resize(
+            calibrationPoints_.size(), 1.0);
+        modelOutputs_.tabulated_.assign(calibrationPoints_.size(), false);
 
         int idx = times_.size() - 2;
+        Size pointIndex = calibrationPoints_.size() - 1;
 
         for (std::map<Date, CalibrationPoint>::reverse_iterator
                  i = calibrationPoints_.rbegin();
-             i != calibrationPoints_.rend(); ++i, --idx) {
+             i != calibrationPoints_.rend(); ++i, --idx, --pointIndex) {
+
+            std::vector<Real> pointInputs;
+            if (incremental) {
+                pointInputs = tabulationInputs(i->second);
+                if (keep && pointInputs == i->second.tabulationInputs_)
+                    continue;
+            }
+            keep = false;
+            i->second.tabulationInputs_.clear();
+            modelOutputs_.tabulated_[pointIndex] = true;
 
             Array discreteDeflatedAnnuities(y_.size(), 0.0);
             Array deflatedFinalPayments;
@@ -482,9 +511,8 @@ namespace QuantLib {
             deflatedAnnuities.enableExtrapolation();
 
             Real digitalsCorrectionFactor = 1.0;
-            modelOutputs_.digitalsAdjustmentFactors_.insert(
-                modelOutputs_.digitalsAdjustmentFactors_.begin(),
-                digitalsCorrectionFactor);
+            modelOutputs_.digitalsAdjustmentFactors_[pointIndex] =
+                digitalsCorrectionFactor;
 
             Real digital = 0.0, swapRate, swapRate0;
 
@@ -495,7 +523,7 @@ namespace QuantLib {
 
                 if (c == 1) {
                     digitalsCorrectionFactor = i->second.annuity_ / digital;
-                    modelOutputs_.digitalsAdjustmentFactors_.front() =
+                    modelOutputs_.digitalsAdjustmentFactors_[pointIndex] =
                         digitalsCorrectionFactor;
                 }
 
@@ -593,16 +621,48 @@ namespace QuantLib {
                     (*discreteNumeraire_)[idx][j] *=
                         modelDeflatedZerobond / marketDeflatedZerobond;
                 }
-                modelOutputs_.adjustmentFactors_.insert(
-                    modelOutputs_.adjustmentFactors_.begin(),
-                    modelDeflatedZerobond / marketDeflatedZerobond);
+                modelOutputs_.adjustmentFactors_[pointIndex] =
+                    modelDeflatedZerobond / marketDeflatedZerobond;
             } else {
-                modelOutputs_.adjustmentFactors_.insert(
-                    modelOutputs_.adjustmentFactors_.begin(), 1.0);
+                modelOutputs_.adjustmentFactors_[pointIndex] = 1.0;
             }
 
             numeraire_[idx]->update();
+            i->second.tabulationInputs_ = pointInputs;
+        }
+
+        tabulationInputs_ = globalInputs;
+    }
+
+    const Disposable<std::vector<Real> >
+    MarkovFunctional::tabulationInputs() const {
+        std::vector<Real> res(reversion_.params().begin(),
+                              reversion_.params().end());
+        res.insert(res.end(), sigma_.params().begin(), sigma_.params().end());
+        res.push_back(termStructure()->discount(numeraireTime_, true));
+        for (Size i = 0; i < times_.size(); i++)
+            res.push_back(termStructure()->discount(times_[i], true));
+        return res;
+    }
+
+    const Disposable<std::vector<Real> >
+    MarkovFunctional::tabulationInputs(const CalibrationPoint &p) const {
+        std::vector<Real> res;
+        res.push_back(p.atm_);
+        res.push_back(p.annuity_);
+        res.push_back(p.minRateDigital_);
+        res.push_back(p.maxRateDigital_);
+        for (Size j = 0; j < p.paymentDates_.size(); j++)
+            res.push_back(termStructure()->discount(p.paymentDates_[j], true));
+        SmileSectionUtils ssutils(*p.rawSmileSection_,
+                                  modelSettings_.smileMoneynessCheckpoints_,
+                                  p.atm_);
+        const std::vector<Real> &k = ssutils.strikeGrid();
+        for (Size j = 0; j < k.size(); j++) {
+            res.push_back(p.smileSection_->optionPrice(k[j], Option::Call,
+                                                       p.annuity_));
         }
+        return res;
     }
 
     const MarkovFunctional::ModelOutputs &
@@ -725,7 +785,11 @@ namespace QuantLib {
         Real tb = times_[i];
         Real dt = tb - ta;
 
-        for (Size j = 0; j < y.size(); j++) {
+        // the interpolations are only read below, so the loop can be
+        // parallelized safely (calculate() was called above); scalar
+        // calls and small arrays are not worth a parallel region
+#pragma omp parallel for default(shared) if(y.size() > 1000)
+        for (long j = 0; j < static_cast<long>(y.size()); j++) {
             Real yv = y[j];
             if (yv < y_.front())
                 yv = y_.front();
@@ -765,15 +829,20 @@ namespace QuantLib {
         Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
         Real stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
 
+        // the numeraire is evaluated on all integration points at once
+        const Size n = modelSettings_.gaussHermitePoints_;
+        Array ya(y.size() * n);
         for (Size j = 0; j < y.size(); j++) {
-            Array ya(modelSettings_.gaussHermitePoints_);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                ya[i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
-                        stdDev_0_T;
+            for (Size i = 0; i < n; i++) {
+                ya[j * n + i] =
+                    (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
+                    stdDev_0_T;
             }
-            Array res = numeraireArray(T, ya);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                result[j] += normalIntegralW_[i] / res[i];
+        }
+        Array res = numeraireArray(T, ya);
+        for (Size j = 0; j < y.size(); j++) {
+            for (Size i = 0; i < n; i++) {
+                result[j] += normalIntegralW_[i] / res[j * n + i];
             }
         }
 
@@ -893,7 +962,11 @@ namespace QuantLib {
                     : "")
             << ((m.settings_.adjustments_ &
                         MarkovFunctional::ModelSettings::SabrSmile)
-                    ? "Sabr"
+                    ? "Sabr "
+                    : "")
+            << ((m.settings_.adjustments_ &
+                        MarkovFunctional::ModelSettings::IncrementalTabulation)
+                    ? "IncrTab"
                     : "")
             << std::endl;
         out << "Smile moneyness checkpoints: ";
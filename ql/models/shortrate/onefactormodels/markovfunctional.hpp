@@ -92,6 +92,15 @@ namespace QuantLib {
       When using a shifted lognormal smile input the lower rate bound is adjusted
       by the shift so that a lower bound of 0.0 always corresponds to the lower
       bound of the shifted distribution.
+
+      IncrementalTabulation lets the model keep the numeraire tabulation for
+      the latest calibration points if neither the model parameters, the yield
+      term structure nor the market data of these points changed since the
+      last tabulation. Since the numeraire at a calibration time depends on the
+      numeraire at all later times, only the points after the latest changed
+      one can be kept. The smiles are compared via their option prices on the
+      strike grid given by the smile moneyness checkpoints, so changes of the
+      input smile between these strikes are not detected.
 */
 
     class MarkovFunctional : public Gaussian1dModel, public CalibratedModel {
@@ -110,7 +119,8 @@ namespace QuantLib {
                 SmileExponentialExtrapolation = 1 << 5,
                 KahaleInterpolation = 1 << 6,
                 SmileDeleteArbitragePoints = 1 << 7,
-                SabrSmile = 1 << 8
+                SabrSmile = 1 << 8,
+                IncrementalTabulation = 1 << 9
             };
 
             ModelSettings()
@@ -240,6 +250,9 @@ namespace QuantLib {
             boost::shared_ptr<SmileSection> rawSmileSection_;
             Real minRateDigital_;
             Real maxRateDigital_;
+            // inputs of the last numeraire tabulation, only used with
+            // IncrementalTabulation
+            std::vector<Real> tabulationInputs_;
         };
 
 // utility macro to write messages to the model outputs
@@ -260,6 +273,9 @@ namespace QuantLib {
             std::vector<Real> annuity_;
             std::vector<Real> adjustmentFactors_;
             std::vector<Real> digitalsAdjustmentFactors_;
+            // calibration points tabulated in the last update, the
+            // others were kept (see IncrementalTabulation)
+            std::vector<bool> tabulated_;
             std::vector<std::string> messages_;
             std::vector<std::vector<Real> > smileStrikes_;
             std::vector<std::vector<Real> > marketRawCallPremium_;
@@ -318,6 +334,7 @@ namespace QuantLib {
         }
 
         void update() {
+            flushConditionalGrids();
             LazyObject::update();
         }
 
@@ -347,6 +364,7 @@ namespace QuantLib {
             // is called twice. If we can not check the lazy object status this seem
             // hard to avoid though.
             calculate();
+            flushConditionalGrids();
             updateNumeraireTabulation();
             notifyObservers();
         }
@@ -373,6 +391,9 @@ namespace QuantLib {
 
         void updateSmiles() const;
         void updateNumeraireTabulation() const;
+        const Disposable<std::vector<Real> > tabulationInputs() const;
+        const Disposable<std::vector<Real> >
+        tabulationInputs(const CalibrationPoint &p) const;
 
         void makeSwaptionCalibrationPoint(const Date &expiry,
                                           const Period &tenor);
@@ -491,6 +512,8 @@ namespace QuantLib {
         mutable std::vector<Real> times_;
         Array y_;
 
+        mutable std::vector<Real> tabulationInputs_;
+
         Array normalIntegralX_;
         Array normalIntegralW_;
 
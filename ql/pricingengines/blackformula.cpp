@@ -25,7 +25,7 @@
 */
 
 #include <ql/pricingengines/blackformula.hpp>
-#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/math/comparison.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -52,6 +52,22 @@ namespace {
                                                      << displacement
                                                      << ") must be positive");
     }
+
+    void checkSizes(QuantLib::Size n,
+                    const std::vector<QuantLib::Real>& forwards,
+                    const std::vector<QuantLib::Real>& values,
+                    const std::vector<QuantLib::Real>& discounts)
+    {
+        QL_REQUIRE(forwards.size() == n,
+                   "wrong number of forwards (" << forwards.size()
+                   << ") given for " << n << " strikes");
+        QL_REQUIRE(values.size() == n,
+                   "wrong number of values (" << values.size()
+                   << ") given for " << n << " strikes");
+        QL_REQUIRE(discounts.size() == n,
+                   "wrong number of discounts (" << discounts.size()
+                   << ") given for " << n << " strikes");
+    }
 }
 
 namespace QuantLib {
@@ -104,6 +120,67 @@ namespace QuantLib {
             payoff->strike(), forward, stdDev, discount, displacement);
     }
 
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement) {
+        Size n = strikes.size();
+        checkSizes(n, forwards, stdDevs, discounts);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+        }
+
+        // the arguments of the cumulative normal are calculated in a
+        // first loop and the distribution is evaluated in a second
+        // one; degenerate cases are sorted out at the end.
+        std::vector<Real> nd1(n), nd2(n);
+        for (Size i=0; i<n; ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real stdDev = stdDevs[i];
+            if (stdDev > 0.0 && strike > 0.0) {
+                Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+                nd1[i] = optionType*d1;
+                nd2[i] = optionType*(d1 - stdDev);
+            } else {
+                nd1[i] = nd2[i] = 0.0;
+            }
+        }
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            nd1[i] = phi(nd1[i]);
+            nd2[i] = phi(nd2[i]);
+        }
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            if (stdDevs[i]==0.0)
+                results[i] = std::max((forwards[i]-strikes[i])*optionType,
+                                      Real(0.0))*discounts[i];
+            else if (strike==0.0)
+                results[i] =
+                    (optionType==Option::Call ? forward*discounts[i] : 0.0);
+            else
+                results[i] = discounts[i] * optionType *
+                    (forward*nd1[i] - strike*nd2[i]);
+            QL_ENSURE(results[i]>=0.0,
+                      "negative value (" << results[i] << ") for " <<
+                      stdDevs[i] << " stdDev, " <<
+                      optionType << " option, " <<
+                      strikes[i] << " strike , " <<
+                      forwards[i] << " forward");
+        }
+        return results;
+    }
+
     Real blackFormulaImpliedStdDevApproximation(Option::Type optionType,
                                                 Real strike,
                                                 Real forward,
@@ -218,55 +295,42 @@ namespace QuantLib {
             blackAtmPrice, discount, displacement);
     }
 
-    class BlackImpliedStdDevHelper {
-      public:
-        BlackImpliedStdDevHelper(Option::Type optionType,
-                                 Real strike,
-                                 Real forward,
-                                 Real undiscountedBlackPrice,
-                                 Real displacement = 0.0)
-        : halfOptionType_(0.5*optionType), signedStrike_(optionType*(strike+displacement)),
-          signedForward_(optionType*(forward+displacement)),
-          undiscountedBlackPrice_(undiscountedBlackPrice)
-        {
-            checkParameters(strike, forward, displacement);
-            QL_REQUIRE(undiscountedBlackPrice>=0.0,
-                       "undiscounted Black price (" <<
-                       undiscountedBlackPrice << ") must be non-negative");
-            signedMoneyness_ = optionType*std::log((forward+displacement)/(strike+displacement));
-        }
-        Real operator()(Real stdDev) const {
-            #if defined(QL_EXTRA_SAFETY_CHECKS)
-            QL_REQUIRE(stdDev>=0.0,
-                       "stdDev (" << stdDev << ") must be non-negative");
-            #endif
-            if (stdDev==0.0)
-                return std::max(signedForward_-signedStrike_, Real(0.0))
-                                                   - undiscountedBlackPrice_;
-            Real temp = halfOptionType_*stdDev;
-            Real d = signedMoneyness_/stdDev;
-            Real signedD1 = d + temp;
-            Real signedD2 = d - temp;
-            Real result = signedForward_ * N_(signedD1)
-                - signedStrike_ * N_(signedD2);
-            // numerical inaccuracies can yield a negative answer
-            return std::max(Real(0.0), result) - undiscountedBlackPrice_;
-        }
-        Real derivative(Real stdDev) const {
-            #if defined(QL_EXTRA_SAFETY_CHECKS)
-            QL_REQUIRE(stdDev>=0.0,
-                       "stdDev (" << stdDev << ") must be non-negative");
-            #endif
-            Real signedD1 = signedMoneyness_/stdDev + halfOptionType_*stdDev;
-            return signedForward_*N_.derivative(signedD1);
-        }
-      private:
-        Real halfOptionType_;
-        Real signedStrike_, signedForward_;
-        Real undiscountedBlackPrice_, signedMoneyness_;
-        CumulativeNormalDistribution N_;
-    };
+    namespace {
+
+        /* Black formula normalised as in P. Jaeckel, "Let's be
+           rational", Wilmott (2015): the price of an out-of-the-money
+           call divided by sqrt(F*K), as a function of x = ln(F/K) <= 0
+           and of the standard deviation s.  The price of an
+           out-of-the-money put is the same with x = ln(K/F).
+        */
+        class NormalisedBlack {
+          public:
+            explicit NormalisedBlack(Real x)
+            : x_(x), expHalfX_(std::exp(0.5*x)) {}
+            Real value(Real s) const {
+                return expHalfX_*N_(x_/s + 0.5*s)
+                    - N_(x_/s - 0.5*s)/expHalfX_;
+            }
+            Real vega(Real s) const {
+                Real h = x_/s, t = 0.5*s;
+                return M_1_SQRTPI*M_SQRT1_2*std::exp(-0.5*(h*h + t*t));
+            }
+            // second and third derivative, divided by the first
+            Real volga(Real s) const {
+                return x_*x_/(s*s*s) - 0.25*s;
+            }
+            Real thirdOverVega(Real s) const {
+                Real v = volga(s);
+                return v*v - 3.0*x_*x_/(s*s*s*s) - 0.25;
+            }
+            // the limit for infinite standard deviation
+            Real maximum() const { return expHalfX_; }
+          private:
+            Real x_, expHalfX_;
+            CumulativeNormalDistribution N_;
+        };
 
+    }
 
     Real blackFormulaImpliedStdDev(Option::Type optionType,
                                    Real strike,
@@ -311,21 +375,96 @@ namespace QuantLib {
         strike = strike + displacement;
         forward = forward + displacement;
 
-        if (guess==Null<Real>())
-            guess = blackFormulaImpliedStdDevApproximation(
-                optionType, strike, forward, blackPrice, discount, displacement);
-        else
+        if (guess!=Null<Real>()) {
             QL_REQUIRE(guess>=0.0,
                        "stdDev guess (" << guess << ") must be non-negative");
-        BlackImpliedStdDevHelper f(optionType, strike, forward,
-                                   blackPrice/discount);
-        NewtonSafe solver;
-        solver.setMaxEvaluations(maxIterations);
-        Real minSdtDev = 0.0, maxStdDev = 24.0; // 24 = 300% * sqrt(60)
-        Real stdDev = solver.solve(f, accuracy, guess, minSdtDev, maxStdDev);
-        QL_ENSURE(stdDev>=0.0,
-                  "stdDev (" << stdDev << ") must be non-negative");
-        return stdDev;
+        }
+
+        if (blackPrice==0.0)
+            return 0.0;
+
+        QL_REQUIRE(strike>0.0,
+                   "null strike + displacement, no implied stdDev exists");
+        Real beta = blackPrice/(discount*std::sqrt(forward*strike));
+        Real x = -std::fabs(std::log(forward/strike));
+
+        NormalisedBlack b(x);
+        QL_REQUIRE(beta<b.maximum(),
+                   "option price (" << blackPrice << ") not below its "
+                   "upper bound (" << discount*std::sqrt(forward*strike)
+                   *b.maximum() << ")");
+
+        // The normalised price is convex below the inflection point
+        // sc and concave above it; the objective function is its log
+        // in the first region (where prices can be tiny) and the
+        // price itself in the second.  Householder steps of third
+        // order are taken inside a bracket that shrinks at each
+        // iteration; Newton or bisection steps are used when they
+        // would leave it.
+        Real sc = std::sqrt(2.0*std::fabs(x));
+        bool lowRegion = x < 0.0 && beta < b.value(sc);
+        Real lo = lowRegion ? 0.0 : sc;
+        Real hi = lowRegion ? sc : QL_MAX_REAL;
+
+        Real s = guess;
+        if (s == Null<Real>() || !(s > lo && s < hi)) {
+            if (x == 0.0)
+                // at the money, the normalised price is 2N(s/2)-1
+                s = 2.0*InverseCumulativeNormal()(0.5*(beta+1.0));
+            else
+                s = blackFormulaImpliedStdDevApproximation(
+                             optionType, strike, forward, blackPrice,
+                             discount, 0.0);
+        }
+        if (!(s > lo && s < hi))
+            s = sc;
+
+        Real logBeta = std::log(beta);
+        for (Natural i=0; i<maxIterations; ++i) {
+            Real value = b.value(s);
+            Real f, d1, d2, d3;
+            if (lowRegion) {
+                if (value <= 0.0) {
+                    // too small to be represented; move right
+                    lo = s;
+                    s = 0.5*(lo+hi);
+                    continue;
+                }
+                Real r = b.vega(s)/value;
+                Real h2 = b.volga(s), h3 = b.thirdOverVega(s);
+                f = std::log(value) - logBeta;
+                d1 = r;
+                d2 = r*(h2 - r);
+                d3 = r*(h3 - 3.0*h2*r + 2.0*r*r);
+            } else {
+                Real vega = b.vega(s);
+                f = value - beta;
+                d1 = vega;
+                d2 = vega*b.volga(s);
+                d3 = vega*b.thirdOverVega(s);
+            }
+
+            // the objective function is increasing
+            if (f > 0.0)
+                hi = s;
+            else
+                lo = s;
+
+            Real newton = -f/d1;
+            Real step = newton * (1.0 + 0.5*newton*d2/d1)
+                / (1.0 + newton*(d2/d1 + newton*d3/(6.0*d1)));
+            Real next = s + step;
+            if (!(next > lo && next < hi)) {
+                next = s + newton;
+                if (!(next > lo && next < hi))
+                    next = hi < QL_MAX_REAL ? 0.5*(lo+hi) : 2.0*s;
+            }
+            if (std::fabs(next - s) <= accuracy)
+                return next;
+            s = next;
+        }
+        QL_FAIL("maximum number of iterations (" << maxIterations
+                << ") exceeded; last stdDev " << s);
     }
 
     Real blackFormulaImpliedStdDev(
@@ -341,6 +480,38 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+    std::vector<Real> blackFormulaImpliedStdDev(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement,
+                                   Real accuracy,
+                                   Natural maxIterations) {
+        Size n = strikes.size();
+        checkSizes(n, forwards, blackPrices, discounts);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+            QL_REQUIRE(blackPrices[i]>=0.0,
+                       "option price (" << blackPrices[i]
+                       << ") must be non-negative");
+        }
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i] = blackFormulaImpliedStdDev(optionType, strikes[i],
+                                                   forwards[i],
+                                                   blackPrices[i],
+                                                   discounts[i],
+                                                   displacement,
+                                                   Null<Real>(),
+                                                   accuracy, maxIterations);
+        return results;
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -415,6 +586,38 @@ namespace QuantLib {
                                      stdDev, discount, displacement);
     }
 
+    std::vector<Real> blackFormulaStdDevDerivative(
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement) {
+        Size n = strikes.size();
+        checkSizes(n, forwards, stdDevs, discounts);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+        }
+
+        CumulativeNormalDistribution phi;
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0 || strike==0.0) {
+                results[i] = 0.0;
+            } else {
+                Real d1 = std::log(forward/strike)/stdDev + .5*stdDev;
+                results[i] = discounts[i] * forward * phi.derivative(d1);
+            }
+        }
+        return results;
+    }
+
     Real blackFormulaStdDevSecondDerivative(Rate strike,
                                             Rate forward,
                                             Real stdDev,
@@ -482,6 +685,43 @@ namespace QuantLib {
             payoff->strike(), forward, stdDev, discount);
     }
 
+    std::vector<Real> bachelierBlackFormula(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts) {
+        Size n = strikes.size();
+        checkSizes(n, forwards, stdDevs, discounts);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+        }
+
+        CumulativeNormalDistribution phi;
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i) {
+            Real stdDev = stdDevs[i];
+            Real d = (forwards[i]-strikes[i])*optionType;
+            if (stdDev==0.0) {
+                results[i] = discounts[i]*std::max(d, 0.0);
+            } else {
+                Real h = d/stdDev;
+                results[i] = discounts[i]*(stdDev*phi.derivative(h)
+                                           + d*phi(h));
+            }
+            QL_ENSURE(results[i]>=0.0,
+                      "negative value (" << results[i] << ") for " <<
+                      stdDev << " stdDev, " <<
+                      optionType << " option, " <<
+                      strikes[i] << " strike , " <<
+                      forwards[i] << " forward");
+        }
+        return results;
+    }
+
     static Real h(Real eta) {
 
         const static Real  A0          = 3.994961687345134e-1;
@@ -584,5 +824,32 @@ namespace QuantLib {
                                      stdDev, discount);
     }
 
+    std::vector<Real> bachelierBlackFormulaStdDevDerivative(
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts) {
+        Size n = strikes.size();
+        checkSizes(n, forwards, stdDevs, discounts);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i] << ") must be positive");
+        }
+
+        CumulativeNormalDistribution phi;
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i) {
+            if (stdDevs[i]==0.0) {
+                results[i] = 0.0;
+            } else {
+                Real d1 = (forwards[i] - strikes[i])/stdDevs[i];
+                results[i] = discounts[i] * phi.derivative(d1);
+            }
+        }
+        return results;
+    }
+
 
 }
@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -57,6 +58,20 @@ namespace QuantLib {
                       Real discount = 1.0,
                       Real displacement = 0.0);
 
+    /*! Black 1976 formula for several options of the same type.
+        The i-th result is the value of the option with the i-th
+        strike, forward, standard deviation and discount; all the
+        inputs are checked before any value is calculated.
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement = 0.0);
+
 
     /*! Approximated Black 1976 implied standard deviation,
         i.e. volatility*sqrt(timeToMaturity).
@@ -120,6 +135,14 @@ namespace QuantLib {
 
     /*! Black 1976 implied standard deviation,
         i.e. volatility*sqrt(timeToMaturity)
+
+        The price of the out-of-the-money option is normalised as in
+        P. Jaeckel, "Let's be rational", Wilmott (2015) and inverted
+        with third-order Householder iterations, on the log of the
+        price below the inflection point of the normalised formula
+        and on the price itself above it.  The iterations stop when
+        the last step is below the given accuracy, which usually
+        gives a result close to machine precision.
     */
     Real blackFormulaImpliedStdDev(Option::Type optionType,
                                    Real strike,
@@ -144,6 +167,21 @@ namespace QuantLib {
                         Real accuracy = 1.0e-6,
                         Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviations of several options of
+        the same type, e.g., the quoted points of a smile.  All the
+        inputs are checked before any standard deviation is
+        calculated.
+    */
+    std::vector<Real> blackFormulaImpliedStdDev(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement = 0.0,
+                                   Real accuracy = 1.0e-6,
+                                   Natural maxIterations = 100);
+
 
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
@@ -182,6 +220,16 @@ namespace QuantLib {
                                       Real discount = 1.0,
                                       Real displacement = 0.0);
 
+    /*! Black 1976 formula for the standard deviation derivative of
+        several options; see the scalar version for details.
+    */
+    std::vector<Real> blackFormulaStdDevDerivative(
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts,
+                                   Real displacement = 0.0);
+
      /*! Black 1976 formula for  derivative with respect to implied vol, this
          is basically the vega, but if you want 1% change multiply by 1%
     */
@@ -255,6 +303,20 @@ namespace QuantLib {
                         Real forward,
                         Real stdDev,
                         Real discount = 1.0);
+
+    /*! Bachelier formula for several options of the same type; all
+        the inputs are checked before any value is calculated.
+
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> bachelierBlackFormula(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts);
     /*! Approximated Bachelier implied volatility
 
         It is calculated using  the analytic implied volatility approximation
@@ -287,6 +349,15 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+    /*! Bachelier formula for the standard deviation derivative of
+        several options; see the scalar version for details.
+    */
+    std::vector<Real> bachelierBlackFormulaStdDevDerivative(
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   const std::vector<Real>& discounts);
+
 }
 
 #endif
@@ -376,6 +376,43 @@ namespace QuantLib {
                                  accuracy, guess);
     }
 
+    std::vector<Rate> BondFunctions::yields(
+                            const std::vector<shared_ptr<Bond> >& bonds,
+                            const std::vector<Real>& cleanPrices,
+                            const DayCounter& dayCounter,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Date settlement,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) {
+        QL_REQUIRE(cleanPrices.size() == bonds.size(),
+                   "wrong number of prices (" << cleanPrices.size()
+                   << ") given for " << bonds.size() << " bonds");
+
+        std::vector<Leg> legs(bonds.size());
+        std::vector<Real> dirtyPrices(bonds.size());
+        std::vector<Date> settlementDates(bonds.size());
+        for (Size i=0; i<bonds.size(); ++i) {
+            const Bond& bond = *bonds[i];
+            Date d = settlement == Date() ? bond.settlementDate() : settlement;
+
+            QL_REQUIRE(BondFunctions::isTradable(bond, d),
+                       "bond #" << i+1 << " non tradable at " << d <<
+                       " (maturity being " << bond.maturityDate() << ")");
+
+            Real dirtyPrice = cleanPrices[i] + bond.accruedAmount(d);
+            dirtyPrices[i] = dirtyPrice / (100.0 / bond.notional(d));
+            settlementDates[i] = d;
+            legs[i] = bond.cashflows();
+        }
+
+        return CashFlows::yields(legs, dirtyPrices, dayCounter, compounding,
+                                 frequency, false, settlementDates,
+                                 settlementDates, accuracy, maxIterations,
+                                 guess);
+    }
+
     Time BondFunctions::duration(const Bond& bond,
                                  const InterestRate& yield,
                                  Duration::Type type,
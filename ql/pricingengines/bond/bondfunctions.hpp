@@ -180,6 +180,21 @@ namespace QuantLib {
                                             frequency, false, settlementDate,
                                             settlementDate, accuracy, guess);
         }
+        //! yields of several bonds
+        /*! The yields are solved independently, in parallel if
+            OpenMP is enabled; a null settlement date stands for the
+            settlement date of each bond.
+        */
+        static std::vector<Rate> yields(
+                        const std::vector<boost::shared_ptr<Bond> >& bonds,
+                        const std::vector<Real>& cleanPrices,
+                        const DayCounter& dayCounter,
+                        Compounding compounding,
+                        Frequency frequency,
+                        Date settlementDate = Date(),
+                        Real accuracy = 1.0e-10,
+                        Size maxIterations = 100,
+                        Rate guess = 0.05);
         static Time duration(const Bond& bond,
                              const InterestRate& yield,
                              Duration::Type type = Duration::Modified,
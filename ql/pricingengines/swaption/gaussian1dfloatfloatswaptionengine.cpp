@@ -19,7 +19,6 @@
 
 #include <ql/pricingengines/swaption/gaussian1dfloatfloatswaptionengine.hpp>
 #include <ql/experimental/coupons/swapspreadindex.hpp> // internal
-#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/payoff.hpp>
 
 namespace QuantLib {
@@ -142,7 +141,6 @@ namespace QuantLib {
             npv1a(2 * integrationPoints_ + 1, 0.0); // arrays for npvs of the
                                                     // underlying
         Array z = model_->yGrid(stddevs_, integrationPoints_);
-        Array p(z.size(), 0.0), pa(z.size(), 0.0);
 
         // for probability computation
         std::vector<Array> npvp0, npvp1;
@@ -226,212 +224,47 @@ namespace QuantLib {
             event0Time = std::max(
                 model_->termStructure()->timeFromReference(event0), 0.0);
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
-
-            for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
-
-                // roll back
-
-                Real price = 0.0, pricea = 0.0;
-                if (event1Time != Null<Real>()) {
-                    Real zSpreadDf = oas_.empty()
-                                         ? 1.0
-                                         : std::exp(-oas_->value() *
-                                                    (event1Time - event0Time));
-                    Array yg =
-                        model_->yGrid(stddevs_, integrationPoints_, event1Time,
-                                      event0Time, event0 > expiry ? z[k] : y);
-                    CubicInterpolation payoff0(
-                        z.begin(), z.end(), npv1.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    CubicInterpolation payoff0a(
-                        z.begin(), z.end(), npv1a.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
-                        p[i] = payoff0(yg[i], true);
-                        pa[i] = payoff0a(yg[i], true);
-                    }
-                    CubicInterpolation payoff1(
-                        z.begin(), z.end(), p.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    CubicInterpolation payoff1a(
-                        z.begin(), z.end(), pa.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < z.size() - 1; i++) {
-                        price += model_->gaussianShiftedPolynomialIntegral(
-                                     0.0, payoff1.cCoefficients()[i],
-                                     payoff1.bCoefficients()[i],
-                                     payoff1.aCoefficients()[i], p[i], z[i],
-                                     z[i], z[i + 1]) *
-                                 zSpreadDf;
-                        pricea += model_->gaussianShiftedPolynomialIntegral(
-                                      0.0, payoff1a.cCoefficients()[i],
-                                      payoff1a.bCoefficients()[i],
-                                      payoff1a.aCoefficients()[i], pa[i], z[i],
-                                      z[i], z[i + 1]) *
-                                  zSpreadDf;
-                    }
-                    if (extrapolatePayoff_) {
-                        if (flatPayoffExtrapolation_) {
-                            price +=
-                                model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
-                                zSpreadDf;
-                            price += model_->gaussianShiftedPolynomialIntegral(
-                                         0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                         z[0]) *
-                                     zSpreadDf;
-                            pricea +=
-                                model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, pa[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
-                                zSpreadDf;
-                            pricea += model_->gaussianShiftedPolynomialIntegral(
-                                          0.0, 0.0, 0.0, 0.0, pa[0], z[0],
-                                          -100.0, z[0]) *
-                                      zSpreadDf;
-                        } else {
-                            if (type == Option::Call)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1.cCoefficients()[z.size() - 2],
-                                        payoff1.bCoefficients()[z.size() - 2],
-                                        payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
-                                    zSpreadDf;
-                            if (type == Option::Put)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
-                                        payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]) *
-                                    zSpreadDf;
-                            if (type == Option::Call)
-                                pricea +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1a.cCoefficients()[z.size() - 2],
-                                        payoff1a.bCoefficients()[z.size() - 2],
-                                        payoff1a.aCoefficients()[z.size() - 2],
-                                        pa[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
-                                    zSpreadDf;
-                            if (type == Option::Put)
-                                pricea +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1a.cCoefficients()[0],
-                                        payoff1a.bCoefficients()[0],
-                                        payoff1a.aCoefficients()[0], pa[0],
-                                        z[0], -100.0, z[0]) *
-                                    zSpreadDf;
-                        }
-                    }
-                }
-
-                npv0[k] = price;
-                npv0a[k] = pricea;
-
+            // roll back the option and underlying values (and the
+            // probability values) from the previous (i.e. later) event
+            if (event1Time != Null<Real>()) {
+                Real zSpreadDf = oas_.empty()
+                                     ? 1.0
+                                     : std::exp(-oas_->value() *
+                                                (event1Time - event0Time));
+                model_->rollback(npv0, npv1, event1Time, event0Time, stddevs_,
+                                 integrationPoints_, extrapolatePayoff_,
+                                 flatPayoffExtrapolation_, type,
+                                 event0 > expiry ? Null<Real>() : y);
+                model_->rollback(npv0a, npv1a, event1Time, event0Time,
+                                 stddevs_, integrationPoints_,
+                                 extrapolatePayoff_, flatPayoffExtrapolation_,
+                                 type, event0 > expiry ? Null<Real>() : y);
+                npv0 *= zSpreadDf;
+                npv0a *= zSpreadDf;
                 // for probability computation
                 if (considerProbabilities && probabilities_ != None) {
                     for (Size m = 0; m < npvp0.size(); m++) {
-                        Real price = 0.0;
-                        if (event1Time != Null<Real>()) {
-                            Real zSpreadDf =
-                                oas_.empty()
-                                    ? 1.0
-                                    : std::exp(-oas_->value() *
-                                               (event1Time - event0Time));
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, event1Time,
-                                event0Time, event0 > expiry ? z[k] : 0.0);
-                            CubicInterpolation payoff0(
-                                z.begin(), z.end(), npvp1[m].begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < yg.size(); i++) {
-                                p[i] = payoff0(yg[i], true);
-                            }
-                            CubicInterpolation payoff1(
-                                z.begin(), z.end(), p.begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < z.size() - 1; i++) {
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[i],
-                                        payoff1.bCoefficients()[i],
-                                        payoff1.aCoefficients()[i], p[i], z[i],
-                                        z[i], z[i + 1]) *
-                                    zSpreadDf;
-                            }
-                            if (extrapolatePayoff_) {
-                                if (flatPayoffExtrapolation_) {
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0,
-                                                  p[z.size() - 2],
-                                                  z[z.size() - 2],
-                                                  z[z.size() - 1], 100.0) *
-                                        zSpreadDf;
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0, p[0],
-                                                  z[0], -100.0, z[0]) *
-                                        zSpreadDf;
-                                } else {
-                                    if (type == Option::Call)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1.cCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.bCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.aCoefficients()
-                                                          [z.size() - 2],
-                                                      p[z.size() - 2],
-                                                      z[z.size() - 2],
-                                                      z[z.size() - 1], 100.0) *
-                                            zSpreadDf;
-                                    if (type == Option::Put)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1
-                                                          .cCoefficients()[0],
-                                                      payoff1
-                                                          .bCoefficients()[0],
-                                                      payoff1
-                                                          .aCoefficients()[0],
-                                                      p[0], z[0], -100.0,
-                                                      z[0]) *
-                                            zSpreadDf;
-                                }
-                            }
-                        }
-
-                        npvp0[m][k] = price;
+                        model_->rollback(
+                            npvp0[m], npvp1[m], event1Time, event0Time,
+                            stddevs_, integrationPoints_, extrapolatePayoff_,
+                            flatPayoffExtrapolation_, type,
+                            event0 > expiry ? Null<Real>() : 0.0);
+                        npvp0[m] *= zSpreadDf;
                     }
                 }
                 // end probability computation
+            } else {
+                std::fill(npv0.begin(), npv0.end(), 0.0);
+                std::fill(npv0a.begin(), npv0a.end(), 0.0);
+                // for probability computation
+                for (Size m = 0; m < npvp0.size(); m++)
+                    std::fill(npvp0[m].begin(), npvp0[m].end(), 0.0);
+                // end probability computation
+            }
+
+            // todo add openmp support later on (as in gaussian1dswaptionengine)
+
+            for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
 
                 // event date calculations
 
@@ -22,7 +22,6 @@
 #include <ql/utilities/disposable.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/quotes/simplequote.hpp>
-#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/payoff.hpp>
 
 using std::exp;
@@ -162,7 +161,6 @@ namespace QuantLib {
         Array npv0(2 * integrationPoints_ + 1, 0.0),
             npv1(2 * integrationPoints_ + 1, 0.0);
         Array z = model_->yGrid(stddevs_, integrationPoints_);
-        Array p(z.size(), 0.0);
 
         // for probability computation
         std::vector<Array> npvp0, npvp1;
@@ -198,166 +196,43 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
-
-            for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
-                 k++) {
-
-                Real price = 0.0;
-                if (expiry1Time != Null<Real>()) {
-                    Real zSpreadDf =
-                        oas_.empty() ? 1.0
-                                     : std::exp(-oas_->value() *
-                                                (expiry1Time - expiry0Time));
-                    Array yg = model_->yGrid(stddevs_, integrationPoints_,
-                                             expiry1Time, expiry0Time,
-                                             expiry0 > settlement ? z[k] : 0.0);
-                    CubicInterpolation payoff0(
-                        z.begin(), z.end(), npv1.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
-                        p[i] = payoff0(yg[i], true);
-                    }
-                    CubicInterpolation payoff1(
-                        z.begin(), z.end(), p.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < z.size() - 1; i++) {
-                        price += model_->gaussianShiftedPolynomialIntegral(
-                                     0.0, payoff1.cCoefficients()[i],
-                                     payoff1.bCoefficients()[i],
-                                     payoff1.aCoefficients()[i], p[i], z[i],
-                                     z[i], z[i + 1]) *
-                                 zSpreadDf;
-                    }
-                    if (extrapolatePayoff_) {
-                        if (flatPayoffExtrapolation_) {
-                            price +=
-                                model_->gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                    z[z.size() - 2], z[z.size() - 1], 100.0) *
-                                zSpreadDf;
-                            price += model_->gaussianShiftedPolynomialIntegral(
-                                         0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0,
-                                         z[0]) *
-                                     zSpreadDf;
-                        } else {
-                            if (type == Option::Call)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1.cCoefficients()[z.size() - 2],
-                                        payoff1.bCoefficients()[z.size() - 2],
-                                        payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0) *
-                                    zSpreadDf;
-                            if (type == Option::Put)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
-                                        payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]) *
-                                    zSpreadDf;
-                        }
-                    }
-                }
-
-                npv0[k] = price;
-
+            // roll back the option value (and the probability values)
+            // from the previous (i.e. later) expiry
+            if (expiry1Time != Null<Real>()) {
+                Real zSpreadDf =
+                    oas_.empty() ? 1.0
+                                 : std::exp(-oas_->value() *
+                                            (expiry1Time - expiry0Time));
+                model_->rollback(npv0, npv1, expiry1Time, expiry0Time,
+                                 stddevs_, integrationPoints_,
+                                 extrapolatePayoff_, flatPayoffExtrapolation_,
+                                 type,
+                                 expiry0 > settlement ? Null<Real>() : 0.0);
+                npv0 *= zSpreadDf;
                 // for probability computation
                 if (probabilities_ != None) {
                     for (Size m = 0; m < npvp0.size(); m++) {
-                        Real price = 0.0;
-                        if (expiry1Time != Null<Real>()) {
-                            Real zSpreadDf =
-                                oas_.empty()
-                                    ? 1.0
-                                    : std::exp(-oas_->value() *
-                                               (expiry1Time - expiry0Time));
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, expiry1Time,
-                                expiry0Time, expiry0 > settlement ? z[k] : 0.0);
-                            CubicInterpolation payoff0(
-                                z.begin(), z.end(), npvp1[m].begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < yg.size(); i++) {
-                                p[i] = payoff0(yg[i], true);
-                            }
-                            CubicInterpolation payoff1(
-                                z.begin(), z.end(), p.begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < z.size() - 1; i++) {
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[i],
-                                        payoff1.bCoefficients()[i],
-                                        payoff1.aCoefficients()[i], p[i], z[i],
-                                        z[i], z[i + 1]) *
-                                    zSpreadDf;
-                            }
-                            if (extrapolatePayoff_) {
-                                if (flatPayoffExtrapolation_) {
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0,
-                                                  p[z.size() - 2],
-                                                  z[z.size() - 2],
-                                                  z[z.size() - 1], 100.0) *
-                                        zSpreadDf;
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0, p[0],
-                                                  z[0], -100.0, z[0]) *
-                                        zSpreadDf;
-                                } else {
-                                    if (type == Option::Call)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1.cCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.bCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.aCoefficients()
-                                                          [z.size() - 2],
-                                                      p[z.size() - 2],
-                                                      z[z.size() - 2],
-                                                      z[z.size() - 1], 100.0) *
-                                            zSpreadDf;
-                                    if (type == Option::Put)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1
-                                                          .cCoefficients()[0],
-                                                      payoff1
-                                                          .bCoefficients()[0],
-                                                      payoff1
-                                                          .aCoefficients()[0],
-                                                      p[0], z[0], -100.0,
-                                                      z[0]) *
-                                            zSpreadDf;
-                                }
-                            }
-                        }
-
-                        npvp0[m][k] = price;
+                        model_->rollback(
+                            npvp0[m], npvp1[m], expiry1Time, expiry0Time,
+                            stddevs_, integrationPoints_, extrapolatePayoff_,
+                            flatPayoffExtrapolation_, type,
+                            expiry0 > settlement ? Null<Real>() : 0.0);
+                        npvp0[m] *= zSpreadDf;
                     }
                 }
                 // end probability computation
+            } else {
+                std::fill(npv0.begin(), npv0.end(), 0.0);
+                // for probability computation
+                for (Size m = 0; m < npvp0.size(); m++)
+                    std::fill(npvp0[m].begin(), npvp0[m].end(), 0.0);
+                // end probability computation
+            }
+
+            // todo add openmp support later on (as in gaussian1dswaptionengine)
+
+            for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
+                 k++) {
 
                 if (expiry0 > settlement) {
                     Real floatingLegNpv = 0.0;
@@ -18,7 +18,6 @@
 */
 
 #include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
-#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/payoff.hpp>
 
 namespace QuantLib {
@@ -52,7 +51,6 @@ namespace QuantLib {
         Array npv0(2 * integrationPoints_ + 1, 0.0),
             npv1(2 * integrationPoints_ + 1, 0.0);
         Array z = model_->yGrid(stddevs_, integrationPoints_);
-        Array p(z.size(), 0.0);
 
         // for probability computation
         std::vector<Array> npvp0, npvp1;
@@ -88,6 +86,33 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
+            // roll back the option value (and the probability values)
+            // from the previous (i.e. later) expiry
+            if (expiry1Time != Null<Real>()) {
+                model_->rollback(npv0, npv1, expiry1Time, expiry0Time,
+                                 stddevs_, integrationPoints_,
+                                 extrapolatePayoff_, flatPayoffExtrapolation_,
+                                 type,
+                                 expiry0 > settlement ? Null<Real>() : 0.0);
+                // for probability computation
+                if (probabilities_ != None) {
+                    for (Size m = 0; m < npvp0.size(); m++) {
+                        model_->rollback(
+                            npvp0[m], npvp1[m], expiry1Time, expiry0Time,
+                            stddevs_, integrationPoints_, extrapolatePayoff_,
+                            flatPayoffExtrapolation_, type,
+                            expiry0 > settlement ? Null<Real>() : 0.0);
+                    }
+                }
+                // end probability computation
+            } else {
+                std::fill(npv0.begin(), npv0.end(), 0.0);
+                // for probability computation
+                for (Size m = 0; m < npvp0.size(); m++)
+                    std::fill(npvp0[m].begin(), npvp0[m].end(), 0.0);
+                // end probability computation
+            }
+
             // a lazy object is not thread safe, neither is the caching
             // in gsrprocess. therefore we trigger computations here such
             // that neither lazy object recalculation nor write access
@@ -95,9 +120,6 @@ namespace QuantLib {
             // this is known to work for the gsr and markov functional
             // model implementations of Gaussian1dModel
 #ifdef _OPENMP
-            if (expiry1Time != Null<Real>())
-                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
-                              expiry0Time, 0.0);
             if (expiry0 > settlement) {
                 for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
                     model_->forwardRate(arguments_.floatingFixingDates[l],
@@ -114,144 +136,10 @@ namespace QuantLib {
             }
 #endif
 
-#pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
+#pragma omp parallel for default(shared) if(expiry0>settlement)
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
                  k++) {
 
-                Real price = 0.0;
-                if (expiry1Time != Null<Real>()) {
-                    Array yg = model_->yGrid(stddevs_, integrationPoints_,
-                                             expiry1Time, expiry0Time,
-                                             expiry0 > settlement ? z[k] : 0.0);
-                    CubicInterpolation payoff0(
-                        z.begin(), z.end(), npv1.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
-                        p[i] = payoff0(yg[i], true);
-                    }
-                    CubicInterpolation payoff1(
-                        z.begin(), z.end(), p.begin(),
-                        CubicInterpolation::Spline, true,
-                        CubicInterpolation::Lagrange, 0.0,
-                        CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < z.size() - 1; i++) {
-                        price += model_->gaussianShiftedPolynomialIntegral(
-                            0.0, payoff1.cCoefficients()[i],
-                            payoff1.bCoefficients()[i],
-                            payoff1.aCoefficients()[i], p[i], z[i], z[i],
-                            z[i + 1]);
-                    }
-                    if (extrapolatePayoff_) {
-                        if (flatPayoffExtrapolation_) {
-                            price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, 0.0, 0.0, 0.0, p[z.size() - 2],
-                                z[z.size() - 2], z[z.size() - 1], 100.0);
-                            price += model_->gaussianShiftedPolynomialIntegral(
-                                0.0, 0.0, 0.0, 0.0, p[0], z[0], -100.0, z[0]);
-                        } else {
-                            if (type == Option::Call)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0,
-                                        payoff1.cCoefficients()[z.size() - 2],
-                                        payoff1.bCoefficients()[z.size() - 2],
-                                        payoff1.aCoefficients()[z.size() - 2],
-                                        p[z.size() - 2], z[z.size() - 2],
-                                        z[z.size() - 1], 100.0);
-                            if (type == Option::Put)
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[0],
-                                        payoff1.bCoefficients()[0],
-                                        payoff1.aCoefficients()[0], p[0], z[0],
-                                        -100.0, z[0]);
-                        }
-                    }
-                }
-
-                npv0[k] = price;
-
-                // for probability computation
-                if (probabilities_ != None) {
-                    for (Size m = 0; m < npvp0.size(); m++) {
-                        Real price = 0.0;
-                        if (expiry1Time != Null<Real>()) {
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, expiry1Time,
-                                expiry0Time, expiry0 > settlement ? z[k] : 0.0);
-                            CubicInterpolation payoff0(
-                                z.begin(), z.end(), npvp1[m].begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < yg.size(); i++) {
-                                p[i] = payoff0(yg[i], true);
-                            }
-                            CubicInterpolation payoff1(
-                                z.begin(), z.end(), p.begin(),
-                                CubicInterpolation::Spline, true,
-                                CubicInterpolation::Lagrange, 0.0,
-                                CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < z.size() - 1; i++) {
-                                price +=
-                                    model_->gaussianShiftedPolynomialIntegral(
-                                        0.0, payoff1.cCoefficients()[i],
-                                        payoff1.bCoefficients()[i],
-                                        payoff1.aCoefficients()[i], p[i], z[i],
-                                        z[i], z[i + 1]);
-                            }
-                            if (extrapolatePayoff_) {
-                                if (flatPayoffExtrapolation_) {
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0,
-                                                  p[z.size() - 2],
-                                                  z[z.size() - 2],
-                                                  z[z.size() - 1], 100.0);
-                                    price +=
-                                        model_
-                                            ->gaussianShiftedPolynomialIntegral(
-                                                  0.0, 0.0, 0.0, 0.0, p[0],
-                                                  z[0], -100.0, z[0]);
-                                } else {
-                                    if (type == Option::Call)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1.cCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.bCoefficients()
-                                                          [z.size() - 2],
-                                                      payoff1.aCoefficients()
-                                                          [z.size() - 2],
-                                                      p[z.size() - 2],
-                                                      z[z.size() - 2],
-                                                      z[z.size() - 1], 100.0);
-                                    if (type == Option::Put)
-                                        price +=
-                                            model_
-                                                ->gaussianShiftedPolynomialIntegral(
-                                                      0.0,
-                                                      payoff1
-                                                          .cCoefficients()[0],
-                                                      payoff1
-                                                          .bCoefficients()[0],
-                                                      payoff1
-                                                          .aCoefficients()[0],
-                                                      p[0], z[0], -100.0, z[0]);
-                                }
-                            }
-                        }
-
-                        npvp0[m][k] = price;
-                    }
-                }
-                // end probability computation
-
                 if (expiry0 > settlement) {
                     Real floatingLegNpv = 0.0;
                     for (Size l = k1; l < arguments_.floatingCoupons.size();
@@ -19,6 +19,7 @@
 */
 
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 
 namespace QuantLib {
@@ -53,15 +54,32 @@ namespace QuantLib {
     };
 
     void JamshidianSwaptionEngine::calculate() const {
+        results_.value = value(arguments_, 0);
+    }
+
+    bool JamshidianSwaptionEngine::hasAnalyticGradient() const {
+        return boost::dynamic_pointer_cast<HullWhite>(*model_) != 0;
+    }
+
+    Real JamshidianSwaptionEngine::valueAndGradient(
+                                      const Swaption::arguments& arguments,
+                                      Array& gradient) const {
+        QL_REQUIRE(hasAnalyticGradient(),
+                   "analytic gradient only available for Hull-White model");
+        return value(arguments, &gradient);
+    }
+
+    Real JamshidianSwaptionEngine::value(const Swaption::arguments& arguments,
+                                         Array* gradient) const {
 
-        QL_REQUIRE(arguments_.settlementType==Settlement::Physical,
+        QL_REQUIRE(arguments.settlementType==Settlement::Physical,
                    "cash-settled swaptions not priced by Jamshidian engine");
 
-        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
                    "cannot use the Jamshidian decomposition "
                    "on exotic swaptions");
 
-        QL_REQUIRE(arguments_.swap->spread() == 0.0, "non zero spread (" << arguments_.swap->spread() << ") not allowed"); // PC
+        QL_REQUIRE(arguments.swap->spread() == 0.0, "non zero spread (" << arguments.swap->spread() << ") not allowed"); // PC
 
         Date referenceDate;
         DayCounter dayCounter;
@@ -76,19 +94,19 @@ namespace QuantLib {
             dayCounter = termStructure_->dayCounter();
         }
 
-        std::vector<Real> amounts(arguments_.fixedCoupons);
-        amounts.back() += arguments_.nominal;
+        std::vector<Real> amounts(arguments.fixedCoupons);
+        amounts.back() += arguments.nominal;
 
         Real maturity = dayCounter.yearFraction(referenceDate,
-                                                arguments_.exercise->date(0));
+                                                arguments.exercise->date(0));
 
-        std::vector<Time> fixedPayTimes(arguments_.fixedPayDates.size());
-        Time valueTime = dayCounter.yearFraction(referenceDate,arguments_.fixedResetDates[0]);
+        std::vector<Time> fixedPayTimes(arguments.fixedPayDates.size());
+        Time valueTime = dayCounter.yearFraction(referenceDate,arguments.fixedResetDates[0]);
         for (Size i=0; i<fixedPayTimes.size(); i++)
             fixedPayTimes[i] = dayCounter.yearFraction(referenceDate,
-                                                       arguments_.fixedPayDates[i]);
+                                                       arguments.fixedPayDates[i]);
 
-        rStarFinder finder(*model_, arguments_.nominal, maturity, valueTime,
+        rStarFinder finder(*model_, arguments.nominal, maturity, valueTime,
                            fixedPayTimes, amounts);
         Brent s1d;
         Rate minStrike = -10.0;
@@ -98,16 +116,26 @@ namespace QuantLib {
         s1d.setUpperBound(maxStrike);
         Rate rStar = s1d.solve(finder, 1e-8, 0.05, minStrike, maxStrike);
 
-        Option::Type w = arguments_.type==VanillaSwap::Payer ?
+        Option::Type w = arguments.type==VanillaSwap::Payer ?
                                                 Option::Put : Option::Call;
-        Size size = arguments_.fixedCoupons.size();
+        Size size = arguments.fixedCoupons.size();
+
+        // the strikes are such that the underlying options are all
+        // exercised in the same states, and their sum weighted by the
+        // amounts is fixed; therefore the derivatives w.r.t. the model
+        // parameters are the ones of the options at constant strikes.
+        boost::shared_ptr<HullWhite> hullWhite;
+        if (gradient) {
+            hullWhite = boost::dynamic_pointer_cast<HullWhite>(*model_);
+            *gradient = Array(model_->params().size(), 0.0);
+        }
 
         Real value = 0.0;
         Real B = model_->discountBond(maturity, valueTime, rStar);
         for (Size i=0; i<size; i++) {
             Real fixedPayTime =
                 dayCounter.yearFraction(referenceDate,
-                                        arguments_.fixedPayDates[i]);
+                                        arguments.fixedPayDates[i]);
             Real strike = model_->discountBond(maturity,
                                                fixedPayTime,
                                                rStar) / B;
@@ -116,8 +144,14 @@ namespace QuantLib {
                                                w, strike, maturity, valueTime,
                                                fixedPayTime);
             value += amounts[i]*dboValue;
+            if (gradient) {
+                Array dboGradient = hullWhite->discountBondOptionGradient(
+                               w, strike, maturity, valueTime, fixedPayTime);
+                for (Size j=0; j<gradient->size(); j++)
+                    (*gradient)[j] += amounts[i]*dboGradient[j];
+            }
         }
-        results_.value = value;
+        return value;
     }
 
 }
@@ -59,7 +59,15 @@ namespace QuantLib {
             registerWith(termStructure_);
         }
         void calculate() const;
+        //! whether the model allows for an analytic gradient
+        bool hasAnalyticGradient() const;
+        //! value and derivatives w.r.t. the model parameters
+        /*! \note this is only available for the Hull-White model */
+        Real valueAndGradient(const Swaption::arguments& arguments,
+                              Array& gradient) const;
       private:
+        Real value(const Swaption::arguments& arguments,
+                   Array* gradient) const;
         Handle<YieldTermStructure> termStructure_;
         class rStarFinder;
         friend class rStarFinder;
@@ -33,6 +33,9 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
+#include <boost/unordered_map.hpp>
+#include <map>
+
 #if defined(QL_PATCH_MSVC)
 #pragma warning(disable: 4180)
 #endif
@@ -82,6 +85,92 @@ namespace QuantLib {
             Real operator()(Real x) const { return int_(1.0-x); }
         };
 
+        /* complex number together with its derivative along one
+           (real) direction in parameter space; used to differentiate
+           the characteristic function in forward mode */
+        class dual {
+          public:
+            dual(const std::complex<Real>& v = 0.0,
+                 const std::complex<Real>& d = 0.0) : v(v), d(d) {}
+            std::complex<Real> v, d;
+        };
+
+        dual operator+(const dual& a, const dual& b) {
+            return dual(a.v+b.v, a.d+b.d);
+        }
+        dual operator-(const dual& a, const dual& b) {
+            return dual(a.v-b.v, a.d-b.d);
+        }
+        dual operator*(const dual& a, const dual& b) {
+            return dual(a.v*b.v, a.d*b.v+a.v*b.d);
+        }
+        dual operator/(const dual& a, const dual& b) {
+            return dual(a.v/b.v, (a.d*b.v-a.v*b.d)/(b.v*b.v));
+        }
+        dual exp(const dual& a) {
+            const std::complex<Real> e = std::exp(a.v);
+            return dual(e, e*a.d);
+        }
+        dual log(const dual& a) {
+            return dual(std::log(a.v), a.d/a.v);
+        }
+        dual sqrt(const dual& a) {
+            const std::complex<Real> s = std::sqrt(a.v);
+            return dual(s, 0.5*a.d/s);
+        }
+
+        /* derivative of the integrand of the price w.r.t. the k-th
+           model parameter (theta, kappa, sigma, rho, v0), based on
+           Gatheral's version of the characteristic function */
+        class GradientIntegrand {
+          public:
+            GradientIntegrand(Real kappa, Real theta, Real sigma,
+                              Real v0, Real rho, Time term,
+                              Real fwdDiscount, Real strikeDiscount,
+                              Real dd, Size k)
+            : term_(term), fwdDiscount_(fwdDiscount),
+              strikeDiscount_(strikeDiscount), dd_(dd) {
+                theta_ = dual(theta, k == 0 ? 1.0 : 0.0);
+                kappa_ = dual(kappa, k == 1 ? 1.0 : 0.0);
+                sigma_ = dual(sigma, k == 2 ? 1.0 : 0.0);
+                rho_   = dual(rho,   k == 3 ? 1.0 : 0.0);
+                v0_    = dual(v0,    k == 4 ? 1.0 : 0.0);
+            }
+
+            Real operator()(Real phi) const {
+                // the integrand has a finite limit for phi -> 0
+                phi = std::max(phi, 1e-8);
+                return (fwdDiscount_*derivative(phi, 1)
+                        - strikeDiscount_*derivative(phi, 2))/phi;
+            }
+
+          private:
+            Real derivative(Real phi, Size j) const {
+                const dual one(1.0), two(2.0);
+                const dual rsigma = rho_*sigma_;
+                const dual sigma2 = sigma_*sigma_;
+                const dual t0 = j == 1 ? kappa_ - rsigma : kappa_;
+                const dual t1 =
+                    t0 - rsigma*dual(std::complex<Real>(0.0, phi));
+                const dual d = sqrt(t1*t1 - sigma2*dual(phi*
+                        std::complex<Real>(-phi, (j == 1) ? 1 : -1)));
+                const dual ex = exp(dual(-term_)*d);
+                const dual p = (t1-d)/(t1+d);
+                const dual g = log((one - p*ex)/(one - p));
+
+                const dual z =
+                    v0_*(t1-d)*(one-ex)/(sigma2*(one-ex*p))
+                    + kappa_*theta_/sigma2*((t1-d)*dual(term_) - two*g)
+                    + dual(std::complex<Real>(0.0, phi*dd_));
+
+                return (std::exp(z.v)*z.d).imag();
+            }
+
+            const Time term_;
+            const Real fwdDiscount_, strikeDiscount_, dd_;
+            dual theta_, kappa_, sigma_, rho_, v0_;
+        };
+
     }
 
     // helper class for integration
@@ -329,6 +418,68 @@ namespace QuantLib {
         }
     }
 
+    /* same as Fj_Helper with Gatheral's complex log, but the strike
+       independent part of the integrand is stored in a cache which
+       is shared between the helpers for options with the same term */
+    class AnalyticHestonEngine::Fj_BatchHelper
+        : public std::unary_function<Real, Real> {
+      public:
+        typedef boost::unordered_map<Real, std::complex<Real> > cache_type;
+
+        Fj_BatchHelper(Real kappa, Real theta, Real sigma,
+                       Real v0, Real s0, Real rho,
+                       const AnalyticHestonEngine* const engine,
+                       Time term, Real strike, Real ratio, Size j,
+                       const boost::shared_ptr<cache_type>& cache)
+        : j_(j), kappa_(kappa), theta_(theta), sigma_(sigma), v0_(v0),
+          term_(term), dx_(std::log(s0/ratio) - std::log(strike)),
+          sigma2_(sigma*sigma), rsigma_(rho*sigma),
+          t0_(kappa - ((j == 1) ? rho*sigma : 0)), engine_(engine),
+          cache_(cache),
+          limit_(kappa, theta, sigma, v0, s0, rho, engine,
+                 Gatheral, term, strike, ratio, j) {}
+
+        Real operator()(Real phi) const {
+            if (phi == 0.0)
+                return limit_(phi);
+
+            cache_type::const_iterator i = cache_->find(phi);
+            if (i == cache_->end())
+                i = cache_->insert(std::make_pair(phi, value(phi))).first;
+
+            return (i->second*std::exp(std::complex<Real>(0.0, phi*dx_)))
+                .imag()/phi;
+        }
+
+      private:
+        std::complex<Real> value(Real phi) const {
+            const std::complex<Real> t1 =
+                t0_+std::complex<Real>(0, -rsigma_*phi);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm =
+                engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                            + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                            + addOnTerm);
+        }
+
+        const Size j_;
+        const Real kappa_, theta_, sigma_, v0_;
+        const Time term_;
+        const Real dx_;
+        const Real sigma2_, rsigma_, t0_;
+        const AnalyticHestonEngine* const engine_;
+        const boost::shared_ptr<cache_type> cache_;
+        const Fj_Helper limit_;
+    };
+
+
     AnalyticHestonEngine::AnalyticHestonEngine(
                               const boost::shared_ptr<HestonModel>& model,
                               Size integrationOrder)
@@ -418,6 +569,144 @@ namespace QuantLib {
         }
     }
 
+    bool AnalyticHestonEngine::hasAnalyticGradient() const {
+        // engines adding jump terms work on models with further
+        // parameters which are not covered by the gradient
+        return model_->params().size() == 5;
+    }
+
+    Disposable<Array> AnalyticHestonEngine::gradient(
+                                        Real strikePrice,
+                                        const Date& exerciseDate) const {
+        QL_REQUIRE(hasAnalyticGradient(),
+                   "analytic gradient not available");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+        const Real spotPrice = process->s0()->value();
+        const Real term = process->time(exerciseDate);
+
+        // for vanishing sigma the formulation below is unstable (see
+        // the pricing code above); we take the derivatives at a small
+        // but finite sigma instead, the price being smooth in sigma.
+        const Real kappa = model_->kappa(), theta = model_->theta(),
+            sigma = std::max(model_->sigma(), 1e-5),
+            v0 = model_->v0(), rho = model_->rho();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        const Real dd = std::log(spotPrice*dividendDiscount
+                                 /(strikePrice*riskFreeDiscount));
+
+        // the derivatives do not depend on the option type
+        // because of the put-call parity
+        Array result(5);
+        for (Size k=0; k<5; ++k) {
+            result[k] = integration_->calculate(c_inf,
+                GradientIntegrand(kappa, theta, sigma, v0, rho, term,
+                                  spotPrice*dividendDiscount,
+                                  strikePrice*riskFreeDiscount, dd, k))/M_PI;
+        }
+        return result;
+    }
+
+    Disposable<Array> AnalyticHestonEngine::prices(
+                        const std::vector<Option::Type>& types,
+                        const std::vector<Real>& strikes,
+                        const std::vector<Date>& exerciseDates) const {
+        QL_REQUIRE(types.size() == strikes.size()
+                   && strikes.size() == exerciseDates.size(),
+                   "types (" << types.size() << "), strikes ("
+                   << strikes.size() << ") and exercise dates ("
+                   << exerciseDates.size() << ") sizes differ");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real kappa = model_->kappa(), theta = model_->theta(),
+            sigma = model_->sigma(), v0 = model_->v0(), rho = model_->rho();
+
+        // group the options by exercise date
+        std::map<Date, std::vector<Size> > groups;
+        for (Size i=0; i<exerciseDates.size(); ++i)
+            groups[exerciseDates[i]].push_back(i);
+
+        Array result(types.size());
+        evaluations_ = 0;
+
+        for (std::map<Date, std::vector<Size> >::const_iterator
+                 g = groups.begin(); g != groups.end(); ++g) {
+
+            const Real riskFreeDiscount =
+                process->riskFreeRate()->discount(g->first);
+            const Real dividendDiscount =
+                process->dividendYield()->discount(g->first);
+            const Real term = process->time(g->first);
+            const std::vector<Size>& options = g->second;
+
+            if (cpxLog_ != Gatheral || sigma <= 1e-5) {
+                for (Size i=0; i<options.size(); ++i) {
+                    const Size k = options[i];
+                    Size evaluations;
+                    doCalculation(riskFreeDiscount, dividendDiscount,
+                                  spotPrice, strikes[k], term,
+                                  kappa, theta, sigma, v0, rho,
+                                  PlainVanillaPayoff(types[k], strikes[k]),
+                                  *integration_, cpxLog_, this,
+                                  result[k], evaluations);
+                    evaluations_ += evaluations;
+                }
+                continue;
+            }
+
+            const Real ratio = riskFreeDiscount/dividendDiscount;
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                    std::sqrt(1.0-square<Real>()(rho))/sigma))
+                    *(v0 + kappa*theta*term);
+
+            const boost::shared_ptr<Fj_BatchHelper::cache_type> cache1(
+                                        new Fj_BatchHelper::cache_type);
+            const boost::shared_ptr<Fj_BatchHelper::cache_type> cache2(
+                                        new Fj_BatchHelper::cache_type);
+
+            for (Size i=0; i<options.size(); ++i) {
+                const Size k = options[i];
+                const Real p1 = integration_->calculate(c_inf,
+                    Fj_BatchHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                                   this, term, strikes[k], ratio, 1,
+                                   cache1))/M_PI;
+                const Real p2 = integration_->calculate(c_inf,
+                    Fj_BatchHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                                   this, term, strikes[k], ratio, 2,
+                                   cache2))/M_PI;
+
+                switch (types[k]) {
+                  case Option::Call:
+                    result[k] = spotPrice*dividendDiscount*(p1+0.5)
+                        - strikes[k]*riskFreeDiscount*(p2+0.5);
+                    break;
+                  case Option::Put:
+                    result[k] = spotPrice*dividendDiscount*(p1-0.5)
+                        - strikes[k]*riskFreeDiscount*(p2-0.5);
+                    break;
+                  default:
+                    QL_FAIL("unknown option type");
+                }
+            }
+            evaluations_ += cache1->size() + cache2->size();
+        }
+
+        return result;
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
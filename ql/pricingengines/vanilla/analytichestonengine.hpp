@@ -105,6 +105,36 @@ namespace QuantLib {
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        //! whether the gradient w.r.t. the model parameters is available
+        bool hasAnalyticGradient() const;
+
+        //! derivatives of the option value w.r.t. the model parameters
+        /*! Returns the derivatives of the value of a European option
+            with the given strike and exercise date w.r.t. theta, kappa,
+            sigma, rho and v0 (i.e., in the order of the model
+            parameters). They are obtained by integrating the
+            derivatives of the characteristic function.
+        */
+        Disposable<Array> gradient(Real strikePrice,
+                                   const Date& exerciseDate) const;
+
+        //! values of several European options at once
+        /*! The i-th returned value is the value of the plain vanilla
+            option with the i-th type, strike and exercise date.
+            Options sharing the same exercise date also share the
+            evaluations of the characteristic function on the nodes
+            of the integration, so that the cost of pricing a whole
+            volatility surface grows with the number of maturities
+            rather than the number of options.
+
+            \note the sharing requires Gatheral's version of the
+                  complex logarithm; otherwise the options are
+                  priced one by one.
+        */
+        Disposable<Array> prices(const std::vector<Option::Type>& types,
+                                 const std::vector<Real>& strikes,
+                                 const std::vector<Date>& exerciseDates) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -127,6 +157,7 @@ namespace QuantLib {
 
       private:
         class Fj_Helper;
+        class Fj_BatchHelper;
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
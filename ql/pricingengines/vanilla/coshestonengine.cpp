@@ -20,6 +20,8 @@
 #include <ql/math/functional.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 
+#include <map>
+
 namespace QuantLib {
 
     COSHestonEngine::COSHestonEngine(
@@ -107,6 +109,86 @@ namespace QuantLib {
             QL_FAIL("unknown payoff type");
     }
 
+    Disposable<Array> COSHestonEngine::prices(
+                        const std::vector<Option::Type>& types,
+                        const std::vector<Real>& strikes,
+                        const std::vector<Date>& exerciseDates) const {
+        QL_REQUIRE(types.size() == strikes.size()
+                   && strikes.size() == exerciseDates.size(),
+                   "types (" << types.size() << "), strikes ("
+                   << strikes.size() << ") and exercise dates ("
+                   << exerciseDates.size() << ") sizes differ");
+
+        const boost::shared_ptr<HestonProcess> process = model_->process();
+
+        const Real spot = process->s0()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        // group the options by exercise date
+        std::map<Date, std::vector<Size> > groups;
+        for (Size i=0; i<exerciseDates.size(); ++i)
+            groups[exerciseDates[i]].push_back(i);
+
+        Array result(types.size());
+        std::vector<Real> U(N_);
+        std::vector<std::complex<Real> > phi(N_);
+
+        for (std::map<Date, std::vector<Size> >::const_iterator
+                 g = groups.begin(); g != groups.end(); ++g) {
+
+            const Date& maturityDate = g->first;
+            const Time maturity = process->time(maturityDate);
+
+            const Real cum1 = c1(maturity);
+            const Real w = std::sqrt(std::fabs(c2(maturity)));
+
+            const Real a = cum1 - L_*w;
+            const Real b = cum1 + L_*w;
+
+            const Real d = 1.0/(b-a);
+
+            const DiscountFactor df
+                = process->riskFreeRate()->discount(maturityDate);
+            const DiscountFactor qf
+                = process->dividendYield()->discount(maturityDate);
+
+            // strike independent part of the series
+            const Real expA = std::exp(a);
+            const Real s0 = characteristicFct(0, maturity).real()
+                *(expA-1-a)*d;
+            for (Size n=1; n < N_; ++n) {
+                const Real r = n*M_PI*d;
+                U[n] = 2.0*d*( 1.0/(1.0 + r*r)
+                    *(expA + r*std::sin(r*a) - std::cos(r*a))
+                    - 1.0/r*std::sin(r*a));
+                phi[n] = characteristicFct(r, maturity);
+            }
+
+            const std::vector<Size>& options = g->second;
+            for (Size i=0; i<options.size(); ++i) {
+                const Size j = options[i];
+                const Real k = strikes[j];
+                const Real x = std::log(spot/k);
+
+                Real s = s0;
+                for (Size n=1; n < N_; ++n) {
+                    const Real r = n*M_PI*d;
+                    s += U[n]*(phi[n]
+                        *std::exp(std::complex<Real>(0, r*(x-a)))).real();
+                }
+
+                if (types[j] == Option::Put)
+                    result[j] = k*df*s;
+                else if (types[j] == Option::Call)
+                    result[j] = spot*qf - k*df*(1-s);
+                else
+                    QL_FAIL("unknown payoff type");
+            }
+        }
+
+        return result;
+    }
+
     Real COSHestonEngine::muT(Time t) const {
         return std::log(  model_->process()->dividendYield()->discount(t)
                         / model_->process()->riskFreeRate()->discount(t));
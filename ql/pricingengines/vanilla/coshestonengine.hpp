@@ -61,6 +61,17 @@ namespace QuantLib {
         void update();
         void calculate() const;
 
+        //! values of several European options at once
+        /*! The i-th returned value is the value of the plain vanilla
+            option with the i-th type, strike and exercise date.
+            Options sharing the same exercise date share the
+            truncation range and the evaluations of the
+            characteristic function.
+        */
+        Disposable<Array> prices(const std::vector<Option::Type>& types,
+                                 const std::vector<Real>& strikes,
+                                 const std::vector<Date>& exerciseDates) const;
+
         std::complex<Real> characteristicFct(Real u, Real t) const;
 
         Real c1(Time t) const;
@@ -23,6 +23,8 @@
            If a single value for the mean reversion is provided, it is assumed
            constant. Results are cached for performance reasons, so if parameters
            change you need to call flushCache() to avoid inconsistent results.
+           The cache is not synchronized, so a process instance must not be
+           shared between threads.
            For a derivation of the formulas, see http://ssrn.com/abstract=2246013
 */
 
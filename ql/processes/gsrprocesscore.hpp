@@ -23,6 +23,9 @@
     \warning Results are cached for performance reasons, so if
              parameters change, you need to call flushCache() to
              avoid inconsistent results.
+    \warning The caches are filled from const methods without any
+             synchronization, so the same instance must not be used
+             by several threads at the same time.
 */
 
 #ifndef quantlib_gsr_process_core_hpp
@@ -73,6 +73,7 @@ namespace QuantLib {
         const std::vector<DiscountFactor>& discounts() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        using YieldTermStructure::discounts;
       protected:
         InterpolatedDiscountCurve(
             const DayCounter&,
@@ -95,6 +96,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, DiscountFactor*) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +170,17 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(
+                                        const std::vector<Time>& t,
+                                        DiscountFactor* results) const {
+        this->interpolation_.values(&t[0], t.size(), results, true);
+        for (Size i=0; i<t.size(); ++i) {
+            if (t[i] > this->times_.back())
+                results[i] = discountImpl(t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
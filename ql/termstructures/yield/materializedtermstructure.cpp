@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2017 The QuantLib contributors
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/yield/materializedtermstructure.hpp>
+
+namespace QuantLib {
+
+    MaterializedTermStructure::MaterializedTermStructure(
+                                  const Handle<YieldTermStructure>& underlying,
+                                  const Period& step,
+                                  const Period& horizon,
+                                  Real accuracy)
+    : underlying_(underlying), step_(step), horizon_(horizon),
+      accuracy_(accuracy) {
+        QL_REQUIRE(step_.length() > 0,
+                   "non-positive sampling step (" << step_ << ") given");
+        QL_REQUIRE(accuracy_ == Null<Real>() || accuracy_ > 0.0,
+                   "non-positive accuracy (" << accuracy_ << ") given");
+        if (!underlying_.empty())
+            enableExtrapolation(underlying_->allowsExtrapolation());
+        registerWith(underlying_);
+    }
+
+    void MaterializedTermStructure::performCalculations() const {
+        QL_REQUIRE(!underlying_.empty(), "no underlying term structure set");
+
+        const Date referenceDate = underlying_->referenceDate();
+        const Date endDate = std::min(underlying_->maxDate(),
+                                      referenceDate + horizon_);
+        QL_REQUIRE(endDate > referenceDate,
+                   "underlying term structure ends at " << endDate
+                   << ", not after its reference date");
+
+        std::vector<Date> dates(1, referenceDate);
+        for (Integer i=1; ; ++i) {
+            Date d = referenceDate + i*step_;
+            if (d >= endDate)
+                break;
+            dates.push_back(d);
+        }
+        dates.push_back(endDate);
+
+        std::vector<DiscountFactor> discounts(dates.size());
+        underlying_->discounts(dates, &discounts[0], true);
+        // the first node flags the reference date for the curve
+        discounts[0] = 1.0;
+
+        curve_ = boost::shared_ptr<DiscountCurve>(
+                    new DiscountCurve(dates, discounts,
+                                      underlying_->dayCounter(),
+                                      underlying_->calendar()));
+        curve_->enableExtrapolation();
+
+        if (accuracy_ != Null<Real>()) {
+            const std::vector<Time>& times = curve_->times();
+            std::vector<Time> midpoints(times.size()-1);
+            for (Size i=0; i<midpoints.size(); ++i)
+                midpoints[i] = 0.5*(times[i]+times[i+1]);
+            std::vector<DiscountFactor> expected(midpoints.size()),
+                                        calculated(midpoints.size());
+            underlying_->discounts(midpoints, &expected[0], true);
+            curve_->discounts(midpoints, &calculated[0]);
+            for (Size i=0; i<midpoints.size(); ++i) {
+                Real error =
+                    std::fabs(calculated[i]-expected[i])/expected[i];
+                QL_REQUIRE(error <= accuracy_,
+                           "sampled discount factor at time " << midpoints[i]
+                           << " differs from the underlying one by "
+                           << error << " (accuracy " << accuracy_
+                           << "); a smaller sampling step is required");
+            }
+        }
+    }
+
+}
@@ -0,0 +1,165 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2017 The QuantLib contributors
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file materializedtermstructure.hpp
+    \brief term structure sampled from another one
+*/
+
+#ifndef quantlib_materialized_term_structure_hpp
+#define quantlib_materialized_term_structure_hpp
+
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    //! Term structure sampled from another one
+    /*! This term structure samples the discount factors of the
+        underlying curve on a regular grid of dates and interpolates
+        them log-linearly.  It can be used to flatten a chain of
+        spreaded or implied term structures into a single curve, so
+        that each discount factor is retrieved without walking the
+        chain.
+
+        The samples are taken lazily and retaken whenever the
+        underlying curve notifies a change.  If an accuracy is given,
+        the interpolated discount factors are compared with those of
+        the underlying curve at the midpoints of the grid and an
+        exception is raised if their relative difference exceeds it.
+
+        The reference date, calendar, settlement days and day counter
+        are those of the underlying curve; the samples end at its
+        maximum date or at the given horizon, whichever comes first,
+        and flat-forward extrapolation is used afterwards.
+
+        \ingroup yieldtermstructures
+
+        \test the sampled discount factors are checked against those
+              of the underlying curve, and the curve is checked to
+              be resampled when the underlying changes.
+    */
+    class MaterializedTermStructure : public YieldTermStructure,
+                                      public LazyObject {
+      public:
+        MaterializedTermStructure(
+                      const Handle<YieldTermStructure>& underlying,
+                      const Period& step = 1*Weeks,
+                      const Period& horizon = 60*Years,
+                      Real accuracy = Null<Real>());
+        //! \name TermStructure interface
+        //@{
+        DayCounter dayCounter() const;
+        Calendar calendar() const;
+        Natural settlementDays() const;
+        const Date& referenceDate() const;
+        Date maxDate() const;
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Date>& dates() const;
+        const std::vector<Time>& times() const;
+        std::vector<std::pair<Date, Real> > nodes() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+      protected:
+        //! \name YieldTermStructure implementation
+        //@{
+        DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, DiscountFactor*) const;
+        //@}
+      private:
+        //! \name LazyObject interface
+        //@{
+        void performCalculations() const;
+        //@}
+        Handle<YieldTermStructure> underlying_;
+        Period step_, horizon_;
+        Real accuracy_;
+        mutable boost::shared_ptr<DiscountCurve> curve_;
+    };
+
+
+    // inline definitions
+
+    inline DayCounter MaterializedTermStructure::dayCounter() const {
+        return underlying_->dayCounter();
+    }
+
+    inline Calendar MaterializedTermStructure::calendar() const {
+        return underlying_->calendar();
+    }
+
+    inline Natural MaterializedTermStructure::settlementDays() const {
+        return underlying_->settlementDays();
+    }
+
+    inline const Date& MaterializedTermStructure::referenceDate() const {
+        return underlying_->referenceDate();
+    }
+
+    inline Date MaterializedTermStructure::maxDate() const {
+        calculate();
+        return curve_->maxDate();
+    }
+
+    inline const std::vector<Date>& MaterializedTermStructure::dates() const {
+        calculate();
+        return curve_->dates();
+    }
+
+    inline const std::vector<Time>& MaterializedTermStructure::times() const {
+        calculate();
+        return curve_->times();
+    }
+
+    inline std::vector<std::pair<Date, Real> >
+    MaterializedTermStructure::nodes() const {
+        calculate();
+        return curve_->nodes();
+    }
+
+    inline void MaterializedTermStructure::update() {
+        // dispatches notifications only if (!calculated_ && !frozen_)
+        LazyObject::update();
+        // do not use TermStructure::update() as it would always
+        // notify observers
+        if (moving_)
+            updated_ = false;
+    }
+
+    inline DiscountFactor
+    MaterializedTermStructure::discountImpl(Time t) const {
+        calculate();
+        return curve_->discount(t, true);
+    }
+
+    inline void MaterializedTermStructure::discountsImpl(
+                                        const std::vector<Time>& t,
+                                        DiscountFactor* results) const {
+        calculate();
+        curve_->discounts(t, results, true);
+    }
+
+}
+
+#endif
@@ -180,6 +180,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>&, DiscountFactor*) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -250,6 +251,14 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(
+                                        const std::vector<Time>& t,
+                                        DiscountFactor* results) const {
+        calculate();
+        base_curve::discountsImpl(t, results);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
@@ -104,6 +104,10 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const std::vector<Time>&, DiscountFactor*) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize(const Compounding& compounding, const Frequency& frequency);
@@ -170,6 +174,21 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(
+                                        const std::vector<Time>& t,
+                                        DiscountFactor* results) const {
+        this->interpolation_.values(&t[0], t.size(), results, true);
+        for (Size i=0; i<t.size(); ++i) {
+            if (t[i] == 0.0)
+                results[i] = 1.0;
+            else if (t[i] > this->times_.back())
+                results[i] = std::exp(-zeroYieldImpl(t[i])*t[i]);
+            else
+                results[i] = std::exp(-results[i]*t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
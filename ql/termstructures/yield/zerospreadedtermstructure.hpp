@@ -69,6 +69,12 @@ namespace QuantLib {
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
+        //! returns the spreaded discount factors
+        /*! If the spread is continuously compounded, the discount
+            factors of the original curve are calculated in a single
+            call and adjusted for the spread.
+        */
+        void discountsImpl(const std::vector<Time>&, DiscountFactor*) const;
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -138,6 +144,23 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::discountsImpl(
+                                        const std::vector<Time>& t,
+                                        DiscountFactor* results) const {
+        if (comp_ != Continuous) {
+            ZeroYieldStructure::discountsImpl(t, results);
+            return;
+        }
+        originalCurve_->discounts(t, results, true);
+        Spread spread = spread_->value();
+        for (Size i=0; i<t.size(); ++i) {
+            if (t[i] == 0.0)
+                results[i] = 1.0;
+            else
+                results[i] *= std::exp(-spread*t[i]);
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
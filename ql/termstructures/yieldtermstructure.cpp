@@ -93,6 +93,42 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    void YieldTermStructure::discounts(const std::vector<Date>& d,
+                                       DiscountFactor* results,
+                                       bool extrapolate) const {
+        std::vector<Time> t(d.size());
+        for (Size i=0; i<d.size(); ++i)
+            t[i] = timeFromReference(d[i]);
+        discounts(t, results, extrapolate);
+    }
+
+    void YieldTermStructure::discounts(const std::vector<Time>& t,
+                                       DiscountFactor* results,
+                                       bool extrapolate) const {
+        if (t.empty())
+            return;
+
+        for (Size i=0; i<t.size(); ++i)
+            checkRange(t[i], extrapolate);
+
+        discountsImpl(t, results);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<t.size(); ++i)
+                results[i] *= jumpEffect(t[i]);
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(const std::vector<Time>& t,
+                                           DiscountFactor* results) const {
+        for (Size i=0; i<t.size(); ++i)
+            results[i] = discountImpl(t[i]);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -110,7 +146,7 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
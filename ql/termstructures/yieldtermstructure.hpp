@@ -77,6 +77,18 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        //! discount factors for several dates
+        /*! The results are written starting at the passed address.
+            Sorted dates are processed in a single pass by most
+            interpolated curves.
+        */
+        void discounts(const std::vector<Date>& d,
+                       DiscountFactor* results,
+                       bool extrapolate = false) const;
+        //! discount factors for several times
+        void discounts(const std::vector<Time>& t,
+                       DiscountFactor* results,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -167,10 +179,17 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factor calculation for several times, possibly
+            unsorted; the default implementation calls discountImpl()
+            for each of them.
+        */
+        virtual void discountsImpl(const std::vector<Time>& t,
+                                   DiscountFactor* results) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -22,9 +22,136 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    Calendar::BusinessDayTable::BusinessDayTable(Size version, Size sources)
+    : first_(1), last_(0), version_(version), sources_(sources) {}
+
+    Calendar::BusinessDayTable::BusinessDayTable(
+                                  const std::vector<boost::uint64_t>& bits,
+                                  Size version, Size sources)
+    : first_(Date::minDate().serialNumber()),
+      last_(Date::maxDate().serialNumber()),
+      bits_(bits), counts_(bits.size()),
+      version_(version), sources_(sources) {
+        QL_REQUIRE(bits_.size() == words(),
+                   "wrong size (" << bits_.size() << ") of business-day "
+                   "bitmap, " << words() << " required");
+        Date::serial_type count = 0;
+        for (Size i=0; i<bits_.size(); ++i) {
+            counts_[i] = count;
+            for (boost::uint64_t w = bits_[i]; w != 0; w &= w-1)
+                ++count;
+        }
+    }
+
+    Size Calendar::BusinessDayTable::words() {
+        Size days = Date::maxDate().serialNumber()
+            - Date::minDate().serialNumber() + 1;
+        return (days + 63)/64;
+    }
+
+    void Calendar::BusinessDayTable::setBusinessDay(Date::serial_type s,
+                                                   bool isBusinessDay) {
+        if (this->isBusinessDay(s) == isBusinessDay)
+            return;
+        const Size i = s - first_;
+        const boost::uint64_t mask = boost::uint64_t(1) << (i & 63);
+        if (isBusinessDay) {
+            bits_[i >> 6] |= mask;
+            for (Size k = (i >> 6)+1; k < counts_.size(); ++k)
+                ++counts_[k];
+        } else {
+            bits_[i >> 6] &= ~mask;
+            for (Size k = (i >> 6)+1; k < counts_.size(); ++k)
+                --counts_[k];
+        }
+    }
+
+    void Calendar::Impl::fillBusinessDays(
+                                 std::vector<boost::uint64_t>& bits) const {
+        const Date::serial_type first = Date::minDate().serialNumber(),
+                                last = Date::maxDate().serialNumber();
+        for (Date::serial_type s = first; s <= last; ++s) {
+            if (isBusinessDay(Date(s))) {
+                const Size i = s - first;
+                bits[i >> 6] |= boost::uint64_t(1) << (i & 63);
+            }
+        }
+    }
+
+    boost::shared_ptr<const Calendar::BusinessDayTable>
+    Calendar::Impl::buildBusinessDays(Size sources) const {
+        // the versions of the underlying calendars are read before
+        // their tables, so that changes made while the table is built
+        // cause another rebuild.  Both terms only increase, so that
+        // the version changes with either of them.
+        const Size version = version_ + sources;
+
+        std::vector<boost::uint64_t> bits(BusinessDayTable::words(), 0);
+        boost::shared_ptr<BusinessDayTable> table;
+        try {
+            fillBusinessDays(bits);
+            table = boost::make_shared<BusinessDayTable>(bits, version,
+                                                         sources);
+        } catch (std::exception&) {
+            // the rules are not defined for some of the dates;
+            // the calendar will use them directly
+            table = boost::make_shared<BusinessDayTable>(version, sources);
+        }
+
+        std::set<Date>::const_iterator i;
+        for (i = addedHolidays.begin(); i != addedHolidays.end(); ++i) {
+            if (table->inRange(i->serialNumber()))
+                table->setBusinessDay(i->serialNumber(), false);
+        }
+        for (i = removedHolidays.begin(); i != removedHolidays.end(); ++i) {
+            if (table->inRange(i->serialNumber()))
+                table->setBusinessDay(i->serialNumber(), true);
+        }
+        boost::shared_ptr<const BusinessDayTable> result = table;
+        boost::atomic_store(&businessDays_, result);
+        return result;
+    }
+
+    void Calendar::Impl::updateBusinessDay(const Date& d) {
+        ++version_;
+        boost::shared_ptr<const BusinessDayTable> current =
+            boost::atomic_load(&businessDays_);
+        if (!current)
+            return;
+        bool changed = true;
+        bool isBusinessDay = false;
+        if (current->inRange(d.serialNumber())) {
+            if (addedHolidays.find(d) != addedHolidays.end())
+                isBusinessDay = false;
+            else if (removedHolidays.find(d) != removedHolidays.end())
+                isBusinessDay = true;
+            else
+                isBusinessDay = this->isBusinessDay(d);
+            changed =
+                current->isBusinessDay(d.serialNumber()) != isBusinessDay;
+        }
+        if (changed) {
+            boost::shared_ptr<BusinessDayTable> table =
+                boost::make_shared<BusinessDayTable>(*current);
+            table->version_ = version_ + table->sources_;
+            if (table->inRange(d.serialNumber()))
+                table->setBusinessDay(d.serialNumber(), isBusinessDay);
+            boost::shared_ptr<const BusinessDayTable> result = table;
+            boost::atomic_store(&businessDays_, result);
+        }
+    }
+
+    void Calendar::Impl::resetBusinessDays() {
+        ++version_;
+        boost::atomic_store(&businessDays_,
+                            boost::shared_ptr<const BusinessDayTable>());
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
         // if d was a genuine holiday previously removed, revert the change
@@ -33,6 +160,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        impl_->updateBusinessDay(d);
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -43,6 +171,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        impl_->updateBusinessDay(d);
     }
 
     Date Calendar::adjust(const Date& d,
@@ -52,10 +181,14 @@ namespace QuantLib {
         if (c == Unadjusted)
             return d;
 
+        QL_REQUIRE(impl_, "no implementation provided");
+        // the same snapshot of the business days is used throughout
+        const boost::shared_ptr<const BusinessDayTable> table =
+            impl_->businessDays();
         Date d1 = d;
         if (c == Following || c == ModifiedFollowing 
             || c == HalfMonthModifiedFollowing) {
-            while (isHoliday(d1))
+            while (!isBusinessDay(*table, d1))
                 d1++;
             if (c == ModifiedFollowing 
                 || c == HalfMonthModifiedFollowing) {
@@ -69,19 +202,19 @@ namespace QuantLib {
                 }
             }
         } else if (c == Preceding || c == ModifiedPreceding) {
-            while (isHoliday(d1))
+            while (!isBusinessDay(*table, d1))
                 d1--;
             if (c == ModifiedPreceding && d1.month() != d.month()) {
                 return adjust(d,Following);
             }
         } else if (c == Nearest) {
             Date d2 = d;
-            while (isHoliday(d1) && isHoliday(d2))
+            while (!isBusinessDay(*table, d1) && !isBusinessDay(*table, d2))
             {
                 d1++;
                 d2--;
             }
-            if (isHoliday(d1))
+            if (!isBusinessDay(*table, d1))
                 return d2;
             else
                 return d1;
@@ -99,18 +232,21 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            QL_REQUIRE(impl_, "no implementation provided");
+            const boost::shared_ptr<const BusinessDayTable> table =
+                impl_->businessDays();
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
                     d1++;
-                    while (isHoliday(d1))
+                    while (!isBusinessDay(*table, d1))
                         d1++;
                     n--;
                 }
             } else {
                 while (n < 0) {
                     d1--;
-                    while(isHoliday(d1))
+                    while(!isBusinessDay(*table, d1))
                         d1--;
                     n++;
                 }
@@ -141,29 +277,33 @@ namespace QuantLib {
                                                     const Date& to,
                                                     bool includeFirst,
                                                     bool includeLast) const {
+        QL_REQUIRE(impl_, "no implementation provided");
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            const boost::shared_ptr<const BusinessDayTable> table =
+                impl_->businessDays();
+            if (table->inRange(first.serialNumber())
+                && table->inRange(last.serialNumber())) {
+                wd = table->businessDaysBefore(last.serialNumber())
+                   - table->businessDaysBefore(first.serialNumber());
+                if (table->isBusinessDay(last.serialNumber()))
+                    ++wd;
+            } else {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
+                for (Date d = first; d < last; ++d) {
+                    if (isBusinessDay(*table, d))
                         ++wd;
                 }
-                if (isBusinessDay(from))
+                if (isBusinessDay(*table, last))
                     ++wd;
             }
 
-            if (isBusinessDay(from) && !includeFirst)
+            if (isBusinessDay(*table, from) && !includeFirst)
                 wd--;
-            if (isBusinessDay(to) && !includeLast)
+            if (isBusinessDay(*table, to) && !includeLast)
                 wd--;
 
             if (from > to)
@@ -30,6 +30,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -58,16 +59,92 @@ namespace QuantLib {
     */
     class Calendar {
       protected:
+        class Impl;
+        //! table of business days over the whole range of valid dates
+        /*! One bit per day, together with the number of business
+            days preceding each 64-day block; this allows to check a
+            date and to count business days between two dates in
+            constant time.  An empty table, for which no date is in
+            range, marks calendars whose rules can't be tabulated.
+        */
+        class BusinessDayTable {
+          public:
+            explicit BusinessDayTable(Size version = 0, Size sources = 0);
+            BusinessDayTable(const std::vector<boost::uint64_t>& bits,
+                             Size version, Size sources = 0);
+            bool empty() const { return bits_.empty(); }
+            //! holiday version of the calendar when the table was built
+            Size version() const { return version_; }
+            //! holiday versions of the underlying calendars, if any
+            Size sources() const { return sources_; }
+            bool inRange(Date::serial_type) const;
+            bool isBusinessDay(Date::serial_type) const;
+            //! number of business days from Date::minDate() to the given date excluded
+            Date::serial_type businessDaysBefore(Date::serial_type) const;
+            void setBusinessDay(Date::serial_type, bool);
+            const std::vector<boost::uint64_t>& bits() const { return bits_; }
+            //! number of words needed to cover the range of valid dates
+            static Size words();
+          private:
+            Date::serial_type first_, last_;
+            std::vector<boost::uint64_t> bits_;
+            std::vector<Date::serial_type> counts_;
+            Size version_, sources_;
+            friend class Impl;
+        };
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            Impl() : composite_(false), version_(0) {}
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            //! business days including added and removed holidays
+            /*! The table is built on first use.  Published tables are
+                never modified; changes to the holidays publish an
+                updated copy, and the replaced table is released by
+                the last thread reading it.  Therefore, the table can
+                be read from several threads, also while another one
+                adds or removes holidays.  If two threads find the
+                table missing, both build it and the last one is kept.
+
+                An empty table is returned if the rules of the
+                calendar are not defined over the whole range of valid
+                dates.
+
+                \warning The sets of added and removed holidays are
+                         not synchronized; they must be modified by one
+                         thread at a time, and not while the calendar
+                         is used for dates outside its table.
+            */
+            boost::shared_ptr<const BusinessDayTable> businessDays() const;
+            //! to be called when the added/removed holidays change
+            void updateBusinessDay(const Date&);
+            //! to be called when the rules of the calendar change
+            void resetBusinessDays();
+          protected:
+            //! sets the bits of the business days in the given table
+            /*! The default implementation tests each date. */
+            virtual void fillBusinessDays(
+                                std::vector<boost::uint64_t>& bits) const;
+            //! sum of the holiday versions of the underlying calendars
+            /*! Only called for composite implementations; their table
+                is rebuilt whenever the returned value changes.
+            */
+            virtual Size sourceVersions() const { return 0; }
+            /*! set to true by implementations depending on other
+                calendars */
+            bool composite_;
+          private:
+            boost::shared_ptr<const BusinessDayTable> buildBusinessDays(
+                                                          Size sources) const;
+            mutable boost::shared_ptr<const BusinessDayTable> businessDays_;
+            Size version_;
         };
         boost::shared_ptr<Impl> impl_;
+        friend class JointCalendar;
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -143,8 +220,31 @@ namespace QuantLib {
                                               const Date& to,
                                               bool includeFirst = true,
                                               bool includeLast = false) const;
+        /*! Builds the table of business days used by the methods
+            above, unless available already, and returns whether the
+            calendar could be tabulated.  The table is otherwise built
+            on first use; this method allows to build it beforehand.
+            It can be called from several threads.
+        */
+        bool tabulateBusinessDays() const;
+        /*! Returns a number which is increased whenever adding or
+            removing holidays changes the business days of the
+            calendar, or of the calendars it is based on.  Together
+            with sharesHolidaysWith(), it allows to tell whether
+            results depending on the holidays are still valid.
+        */
+        Size holidayVersion() const;
+        /*! Returns <tt>true</tt> iff the two calendars share their
+            implementation, so that holidays added to one of them are
+            also added to the other.  This is the case for copies of
+            a calendar and, for most markets, for different instances
+            of the same class.
+        */
+        bool sharesHolidaysWith(const Calendar&) const;
         //@}
 
+      private:
+        bool isBusinessDay(const BusinessDayTable&, const Date&) const;
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -194,8 +294,50 @@ namespace QuantLib {
         return impl_->name();
     }
 
-    inline bool Calendar::isBusinessDay(const Date& d) const {
-        QL_REQUIRE(impl_, "no implementation provided");
+    inline bool
+    Calendar::BusinessDayTable::inRange(Date::serial_type s) const {
+        return s >= first_ && s <= last_;
+    }
+
+    inline bool
+    Calendar::BusinessDayTable::isBusinessDay(Date::serial_type s) const {
+        const Size i = s - first_;
+        return ((bits_[i >> 6] >> (i & 63)) & 1) != 0;
+    }
+
+    inline Date::serial_type
+    Calendar::BusinessDayTable::businessDaysBefore(Date::serial_type s) const {
+        const Size i = s - first_;
+        boost::uint64_t w =
+            bits_[i >> 6] & ((boost::uint64_t(1) << (i & 63)) - 1);
+        // population count of the remaining bits
+        w = w - ((w >> 1) & 0x5555555555555555ULL);
+        w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+        w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return counts_[i >> 6]
+            + static_cast<Date::serial_type>((w * 0x0101010101010101ULL) >> 56);
+    }
+
+    inline boost::shared_ptr<const Calendar::BusinessDayTable>
+    Calendar::Impl::businessDays() const {
+        boost::shared_ptr<const BusinessDayTable> table =
+            boost::atomic_load(&businessDays_);
+        if (!composite_) {
+            if (!table)
+                table = buildBusinessDays(0);
+        } else {
+            const Size sources = sourceVersions();
+            if (!table || table->sources() != sources)
+                table = buildBusinessDays(sources);
+        }
+        return table;
+    }
+
+    inline bool Calendar::isBusinessDay(const BusinessDayTable& table,
+                                        const Date& d) const {
+        const Date::serial_type s = d.serialNumber();
+        if (table.inRange(s))
+            return table.isBusinessDay(s);
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
@@ -203,6 +345,25 @@ namespace QuantLib {
         return impl_->isBusinessDay(d);
     }
 
+    inline bool Calendar::isBusinessDay(const Date& d) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return isBusinessDay(*impl_->businessDays(), d);
+    }
+
+    inline bool Calendar::tabulateBusinessDays() const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return !impl_->businessDays()->empty();
+    }
+
+    inline Size Calendar::holidayVersion() const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return impl_->businessDays()->version();
+    }
+
+    inline bool Calendar::sharesHolidaysWith(const Calendar& c) const {
+        return impl_ == c.impl_;
+    }
+
     inline bool Calendar::isEndOfMonth(const Date& d) const {
         return (d.month() != adjust(d+1).month());
     }
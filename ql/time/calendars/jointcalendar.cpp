@@ -20,6 +20,7 @@
 
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace QuantLib {
@@ -28,6 +29,7 @@ namespace QuantLib {
                               const Calendar& c2,
                               JointCalendarRule r)
     : rule_(r), calendars_(2) {
+        composite_ = true;
         calendars_[0] = c1;
         calendars_[1] = c2;
     }
@@ -37,6 +39,7 @@ namespace QuantLib {
                               const Calendar& c3,
                               JointCalendarRule r)
     : rule_(r), calendars_(3) {
+        composite_ = true;
         calendars_[0] = c1;
         calendars_[1] = c2;
         calendars_[2] = c3;
@@ -48,6 +51,7 @@ namespace QuantLib {
                               const Calendar& c4,
                               JointCalendarRule r)
     : rule_(r), calendars_(4) {
+        composite_ = true;
         calendars_[0] = c1;
         calendars_[1] = c2;
         calendars_[2] = c3;
@@ -115,6 +119,53 @@ namespace QuantLib {
     }
 
 
+    void JointCalendar::Impl::fillBusinessDays(
+                                 std::vector<boost::uint64_t>& bits) const {
+        std::vector<Calendar>::const_iterator i;
+        switch (rule_) {
+          case JoinHolidays:
+            std::fill(bits.begin(), bits.end(), ~boost::uint64_t(0));
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const boost::shared_ptr<const BusinessDayTable> table =
+                    JointCalendar::businessDays(*i);
+                const std::vector<boost::uint64_t>& b = table->bits();
+                for (Size k=0; k<bits.size(); ++k)
+                    bits[k] &= b[k];
+            }
+            break;
+          case JoinBusinessDays:
+            std::fill(bits.begin(), bits.end(), boost::uint64_t(0));
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const boost::shared_ptr<const BusinessDayTable> table =
+                    JointCalendar::businessDays(*i);
+                const std::vector<boost::uint64_t>& b = table->bits();
+                for (Size k=0; k<bits.size(); ++k)
+                    bits[k] |= b[k];
+            }
+            break;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
+    Size JointCalendar::Impl::sourceVersions() const {
+        Size versions = 0;
+        std::vector<Calendar>::const_iterator i;
+        for (i=calendars_.begin(); i!=calendars_.end(); ++i)
+            versions += i->holidayVersion();
+        return versions;
+    }
+
+    boost::shared_ptr<const Calendar::BusinessDayTable>
+    JointCalendar::businessDays(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no implementation provided");
+        boost::shared_ptr<const BusinessDayTable> table =
+            c.impl_->businessDays();
+        QL_REQUIRE(!table->empty(), c.name() << " calendar not tabulated");
+        return table;
+    }
+
+
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
                                  JointCalendarRule r) {
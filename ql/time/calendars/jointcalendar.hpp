@@ -65,10 +65,15 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+          protected:
+            void fillBusinessDays(std::vector<boost::uint64_t>&) const;
+            Size sourceVersions() const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
         };
+        static boost::shared_ptr<const BusinessDayTable> businessDays(
+                                                           const Calendar&);
       public:
         JointCalendar(const Calendar&, const Calendar&,
                       JointCalendarRule = JoinHolidays);
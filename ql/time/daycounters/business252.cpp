@@ -19,54 +19,14 @@
 */
 
 #include <ql/time/daycounters/business252.hpp>
-#include <map>
 
 namespace QuantLib {
 
-    namespace {
-
-        typedef std::map<Year, std::map<Month, Date::serial_type> > Cache;
-        typedef std::map<Year, Date::serial_type> OuterCache;
-        
-        std::map<std::string, Cache> monthlyFigures_;
-        std::map<std::string, OuterCache> yearlyFigures_;
-
-        bool sameYear(const Date& d1, const Date& d2) {
-            return d1.year() == d2.year();
-        }
-
-        bool sameMonth(const Date& d1, const Date& d2) {
-            return d1.year() == d2.year() && d1.month() == d2.month();
-        }
-
-        Date::serial_type businessDays(Cache& cache,
-                                       const Calendar& calendar,
-                                       Month month, Year year) {
-            if (cache[year][month] == 0) {
-                // calculate and store.
-                Date d1 = Date(1,month,year);
-                Date d2 = d1 + 1*Months;
-                cache[year][month] = calendar.businessDaysBetween(d1, d2);
-            }
-            return cache[year][month];
-        }
-
-        Date::serial_type businessDays(OuterCache& outerCache,
-                                       Cache& cache,
-                                       const Calendar& calendar,
-                                       Year year) {
-            if (outerCache[year] == 0) {
-                // calculate and store.
-                Date::serial_type total = 0;
-                for (Integer i=1; i<=12; ++i) {
-                    total += businessDays(cache,calendar,
-                                          Month(i), year);
-                }
-                outerCache[year] = total;
-            }
-            return outerCache[year];
-        }
-
+    Business252::Impl::Impl(const Calendar& c) : calendar_(c) {
+        // build the business-day table of the calendar here, so that
+        // dayCount() only reads it afterwards.  Calendars that can't
+        // be tabulated count business days one by one.
+        calendar_.tabulateBusinessDays();
     }
 
     std::string Business252::Impl::name() const {
@@ -77,61 +37,9 @@ namespace QuantLib {
 
     Date::serial_type Business252::Impl::dayCount(const Date& d1,
                                                   const Date& d2) const {
-        if (sameMonth(d1,d2) || d1 >= d2) {
-            // we treat the case of d1 > d2 here, since we'd need a
-            // second cache to get it right (our cached figures are
-            // for first included, last excluded and might have to be
-            // changed going the other way.)
-            return calendar_.businessDaysBetween(d1, d2);
-        } else if (sameYear(d1,d2)) {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            Date::serial_type total = 0;
-            Date d;
-            // first, we get to the beginning of next month.
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // then, we add any whole months (whose figures might be
-            // cached already) in the middle of our period.
-            while (!sameMonth(d,d2)) {
-                total += businessDays(cache, calendar_,
-                                      d.month(), d.year());
-                d += 1*Months;
-            }
-            // finally, we get to the end of the period.
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        } else {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            OuterCache& outerCache = yearlyFigures_[calendar_.name()];
-            Date::serial_type total = 0;
-            Date d;
-            // first, we get to the beginning of next year.
-            // The first bit gets us to the end of this month...
-            d = Date(1,d1.month(),d1.year()) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // ...then we add any remaining months, possibly cached
-            for (Integer m = Integer(d1.month())+1; m <= 12; ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d.year());
-            }
-            // then, we add any whole year in the middle of our period.
-            d = Date(1,January,d1.year()+1);
-            while (!sameYear(d,d2)) {
-                total += businessDays(outerCache, cache,
-                                      calendar_, d.year());
-                d += 1*Years;
-            }
-            // finally, we get to the end of the period.
-            // First, we add whole months...
-            for (Integer m = 1; m<Integer(d2.month()); ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d2.year());
-            }
-            // ...then the last bit.
-            d = Date(1,d2.month(),d2.year());
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        }
+        // the calendar keeps a cumulative count of business days,
+        // so this takes constant time
+        return calendar_.businessDaysBetween(d1, d2);
     }
 
     Time Business252::Impl::yearFraction(const Date& d1,
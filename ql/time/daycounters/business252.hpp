@@ -32,7 +32,14 @@
 namespace QuantLib {
 
     //! Business/252 day count convention
-    /*! \ingroup daycounters */
+    /*! Business days are counted in constant time by means of the
+        business-day table of the calendar, which is built when the
+        day counter is created.  This includes joint calendars whose
+        components can be tabulated; for other calendars, the count
+        takes time proportional to the number of days.
+
+        \ingroup daycounters
+    */
     class Business252 : public DayCounter {
       private:
         class Impl : public DayCounter::Impl {
@@ -46,7 +53,7 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
-            Impl(Calendar c) { calendar_ = c; }
+            explicit Impl(const Calendar& c);
         };
       public:
         Business252(Calendar c = Brazil())
@@ -526,7 +526,7 @@ namespace QuantLib {
     }
 
     MakeSchedule::MakeSchedule()
-    : rule_(DateGeneration::Backward), endOfMonth_(false) {}
+    : rule_(DateGeneration::Backward), endOfMonth_(false), cached_(false) {}
 
     MakeSchedule& MakeSchedule::from(const Date& effectiveDate) {
         effectiveDate_ = effectiveDate;
@@ -594,6 +594,11 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeSchedule& MakeSchedule::cached(bool flag) {
+        cached_ = flag;
+        return *this;
+    }
+
     MakeSchedule::operator Schedule() const {
         // check for mandatory arguments
         QL_REQUIRE(effectiveDate_ != Date(), "effective date not provided");
@@ -631,9 +636,131 @@ namespace QuantLib {
             calendar = NullCalendar();
         }
 
+        if (cached_)
+            return *ScheduleCache::instance().schedule(
+                        effectiveDate_, terminationDate_, *tenor_, calendar,
+                        convention, terminationDateConvention,
+                        rule_, endOfMonth_, firstDate_, nextToLastDate_);
+
         return Schedule(effectiveDate_, terminationDate_, *tenor_, calendar,
                         convention, terminationDateConvention,
                         rule_, endOfMonth_, firstDate_, nextToLastDate_);
     }
 
+
+    ScheduleCache::ScheduleCache()
+    : capacity_(1000) {}
+
+    boost::shared_ptr<const Schedule> ScheduleCache::schedule(
+                                 const Date& effectiveDate,
+                                 const Date& terminationDate,
+                                 const Period& tenor,
+                                 const Calendar& calendar,
+                                 BusinessDayConvention convention,
+                                 BusinessDayConvention terminationConvention,
+                                 DateGeneration::Rule rule,
+                                 bool endOfMonth,
+                                 const Date& firstDate,
+                                 const Date& nextToLastDate) {
+        if (effectiveDate == Date()) {
+            // the generated dates depend on the evaluation date
+            return boost::shared_ptr<const Schedule>(
+                new Schedule(effectiveDate, terminationDate, tenor, calendar,
+                             convention, terminationConvention, rule,
+                             endOfMonth, firstDate, nextToLastDate));
+        }
+
+        Key key;
+        key.effectiveDate = effectiveDate;
+        key.terminationDate = terminationDate;
+        key.tenor = tenor;
+        key.calendar = calendar;
+        key.holidayVersion = calendar.holidayVersion();
+        key.convention = convention;
+        key.terminationConvention = terminationConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate;
+        key.nextToLastDate = nextToLastDate;
+
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+
+        schedule_map::const_iterator i = schedules_.find(key);
+        if (i != schedules_.end())
+            return i->second;
+
+        boost::shared_ptr<const Schedule> result(
+            new Schedule(effectiveDate, terminationDate, tenor, calendar,
+                         convention, terminationConvention, rule, endOfMonth,
+                         firstDate, nextToLastDate));
+        if (schedules_.size() >= capacity_)
+            schedules_.clear();
+        if (capacity_ > 0)
+            schedules_[key] = result;
+        return result;
+    }
+
+    Size ScheduleCache::size() const {
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+        return schedules_.size();
+    }
+
+    Size ScheduleCache::capacity() const {
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+        return capacity_;
+    }
+
+    void ScheduleCache::setCapacity(Size capacity) {
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+        capacity_ = capacity;
+        if (schedules_.size() > capacity_)
+            schedules_.clear();
+    }
+
+    void ScheduleCache::clear() {
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+        schedules_.clear();
+    }
+
+    bool ScheduleCache::Key::operator==(const Key& other) const {
+        return effectiveDate == other.effectiveDate
+            && terminationDate == other.terminationDate
+            && tenor.length() == other.tenor.length()
+            && tenor.units() == other.tenor.units()
+            && calendar.sharesHolidaysWith(other.calendar)
+            && holidayVersion == other.holidayVersion
+            && convention == other.convention
+            && terminationConvention == other.terminationConvention
+            && rule == other.rule
+            && endOfMonth == other.endOfMonth
+            && firstDate == other.firstDate
+            && nextToLastDate == other.nextToLastDate;
+    }
+
+    std::size_t ScheduleCache::KeyHash::operator()(const Key& key) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, key.effectiveDate.serialNumber());
+        boost::hash_combine(seed, key.terminationDate.serialNumber());
+        boost::hash_combine(seed, key.tenor.length());
+        boost::hash_combine(seed, Integer(key.tenor.units()));
+        boost::hash_combine(seed, key.holidayVersion);
+        boost::hash_combine(seed, Integer(key.convention));
+        boost::hash_combine(seed, Integer(key.terminationConvention));
+        boost::hash_combine(seed, Integer(key.rule));
+        boost::hash_combine(seed, key.endOfMonth);
+        boost::hash_combine(seed, key.firstDate.serialNumber());
+        boost::hash_combine(seed, key.nextToLastDate.serialNumber());
+        return seed;
+    }
+
 }
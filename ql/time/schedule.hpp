@@ -30,8 +30,16 @@
 #include <ql/utilities/null.hpp>
 #include <ql/time/period.hpp>
 #include <ql/time/dategenerationrule.hpp>
+#include <ql/patterns/singleton.hpp>
 #include <ql/errors.hpp>
 #include <boost/optional.hpp>
+#include <boost/unordered_map.hpp>
+
+#if defined(QL_SINGLETON_THREAD_SAFE_INIT) \
+    || defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    #include <boost/thread/mutex.hpp>
+    #define QL_SCHEDULE_CACHE_THREAD_SAFE
+#endif
 
 namespace QuantLib {
 
@@ -134,6 +142,11 @@ namespace QuantLib {
         MakeSchedule& endOfMonth(bool flag=true);
         MakeSchedule& withFirstDate(const Date& d);
         MakeSchedule& withNextToLastDate(const Date& d);
+        //! use the global schedule cache
+        /*! The returned schedule is a copy of the cached one; use
+            ScheduleCache::schedule() directly to share it.
+        */
+        MakeSchedule& cached(bool flag=true);
         operator Schedule() const;
       private:
         Calendar calendar_;
@@ -144,6 +157,81 @@ namespace QuantLib {
         DateGeneration::Rule rule_;
         bool endOfMonth_;
         Date firstDate_, nextToLastDate_;
+        bool cached_;
+    };
+
+    //! global cache of rule-based schedules
+    /*! Schedules are generated once for each set of arguments and
+        shared afterwards; this saves repeated date generation when
+        many instruments (e.g., the swaps underlying a set of rate
+        helpers) are built with the same conventions.
+
+        Calendars are identified by their implementation, so that
+        distinct calendars with the same name (e.g., bespoke ones)
+        don't share schedules, and by their holiday version, so that
+        schedules generated before holidays were added to or removed
+        from a calendar are not returned afterwards; the latter are
+        dropped when the cache reaches its capacity.
+
+        The cache is only used when requested, e.g., through
+        MakeSchedule::cached().  Access to it is synchronized when
+        the library is built for use from several threads, i.e.,
+        with thread-safe singleton initialization or with the
+        thread-safe observer pattern; otherwise, it must be used
+        from a single thread, or from a single thread per session
+        when sessions are enabled.
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache();
+      public:
+        //! returns the schedule for the given arguments
+        /*! The arguments are the same as those of the rule-based
+            Schedule constructor; the schedule is generated if it
+            was not requested before.
+        */
+        boost::shared_ptr<const Schedule> schedule(
+                                 const Date& effectiveDate,
+                                 const Date& terminationDate,
+                                 const Period& tenor,
+                                 const Calendar& calendar,
+                                 BusinessDayConvention convention,
+                                 BusinessDayConvention terminationConvention,
+                                 DateGeneration::Rule rule,
+                                 bool endOfMonth,
+                                 const Date& firstDate = Date(),
+                                 const Date& nextToLastDate = Date());
+        //! number of stored schedules
+        Size size() const;
+        //! maximum number of stored schedules (1000 by default)
+        Size capacity() const;
+        void setCapacity(Size);
+        //! removes all stored schedules
+        void clear();
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Period tenor;
+            // held to keep the implementation from being reused
+            Calendar calendar;
+            Size holidayVersion;
+            BusinessDayConvention convention, terminationConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator==(const Key&) const;
+        };
+        struct KeyHash {
+            std::size_t operator()(const Key&) const;
+        };
+        typedef boost::unordered_map<Key, boost::shared_ptr<const Schedule>,
+                                     KeyHash> schedule_map;
+        schedule_map schedules_;
+        Size capacity_;
+        #if defined(QL_SCHEDULE_CACHE_THREAD_SAFE)
+        mutable boost::mutex mutex_;
+        #endif
     };
 
 
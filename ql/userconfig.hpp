@@ -91,6 +91,25 @@
 //#    define QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
 #endif
 
+/* Define this to reprice calibration helpers concurrently during
+   model calibration (this requires OpenMP). Helpers sharing a pricing
+   engine are repriced serially. Helpers should not use the implied
+   volatility error unless the thread-safe observer pattern is
+   enabled. Models caching intermediate results, such as Gsr and
+   MarkovFunctional, must not be calibrated this way. */
+#ifndef QL_ENABLE_PARALLEL_CALIBRATION
+//#    define QL_ENABLE_PARALLEL_CALIBRATION
+#endif
+
+/* Define this to use BLAS and LAPACK for matrix products, Cholesky
+   and symmetric eigenvalue decompositions of all but the smallest
+   matrices. The library and the programs using it must then be
+   linked to a BLAS and LAPACK implementation exporting the Fortran
+   interface (e.g., OpenBLAS or MKL). */
+#ifndef QL_USE_BLAS
+//#    define QL_USE_BLAS
+#endif
+
 /* Define this to make Singleton initialization thread-safe.
    Note: There is no support for thread safety and multiple sessions.
 */
@@ -0,0 +1,123 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file alignedarray.hpp
+    \brief scoped array with aligned storage
+*/
+
+#ifndef quantlib_aligned_array_hpp
+#define quantlib_aligned_array_hpp
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace QuantLib {
+
+    //! scoped array with aligned storage
+    /*! This class can replace <tt>boost::scoped_array</tt> for arrays
+        of built-in types; the first element is aligned to a 64-byte
+        boundary, i.e., to a cache line and to the width of the widest
+        SIMD registers currently available.  As for
+        <tt>boost::scoped_array</tt>, the elements are not initialized.
+    */
+    template <class T>
+    class AlignedArray : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+      public:
+        enum { alignment = 64 };
+        //! allocates the given number of elements
+        explicit AlignedArray(Size size = 0);
+        ~AlignedArray();
+        //! releases the current storage and allocates a new one
+        void reset(Size size = 0);
+        T* get() const;
+        T& operator[](Size i) const;
+        void swap(AlignedArray&);  // never throws
+      private:
+        static T* allocate(Size size);
+        static void deallocate(T* p);
+        T* data_;
+    };
+
+
+    // inline definitions
+
+    template <class T>
+    inline AlignedArray<T>::AlignedArray(Size size)
+    : data_(allocate(size)) {}
+
+    template <class T>
+    inline AlignedArray<T>::~AlignedArray() {
+        deallocate(data_);
+    }
+
+    template <class T>
+    inline void AlignedArray<T>::reset(Size size) {
+        T* p = allocate(size);
+        deallocate(data_);
+        data_ = p;
+    }
+
+    template <class T>
+    inline T* AlignedArray<T>::get() const {
+        return data_;
+    }
+
+    template <class T>
+    inline T& AlignedArray<T>::operator[](Size i) const {
+        return data_[i];
+    }
+
+    template <class T>
+    inline void AlignedArray<T>::swap(AlignedArray<T>& from) {
+        T* p = data_;
+        data_ = from.data_;
+        from.data_ = p;
+    }
+
+    template <class T>
+    inline T* AlignedArray<T>::allocate(Size size) {
+        if (size == 0)
+            return 0;
+        // the block returned by malloc is aligned at least as a
+        // pointer; moving to the next aligned address leaves room
+        // for storing the original address right before the data
+        char* raw = static_cast<char*>(
+                             std::malloc(size*sizeof(T) + alignment));
+        if (raw == 0)
+            throw std::bad_alloc();
+        std::size_t offset =
+            alignment - reinterpret_cast<std::size_t>(raw) % alignment;
+        char* aligned = raw + offset;
+        reinterpret_cast<char**>(aligned)[-1] = raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    template <class T>
+    inline void AlignedArray<T>::deallocate(T* p) {
+        if (p != 0)
+            std::free(reinterpret_cast<char**>(p)[-1]);
+    }
+
+}
+
+
+#endif
@@ -59,6 +59,11 @@ namespace QuantLib {
             return temp;
         }
         \endcode
+                 For the same reason, a returned value should be
+                 stored as a <tt>Foo</tt> rather than as a named
+                 <tt>Disposable\<Foo\></tt>; the latter is emptied by
+                 the first copy and, for arrays, by the first
+                 arithmetic operation using it.
     */
     template <class T>
     class Disposable : public T {
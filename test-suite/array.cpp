@@ -19,7 +19,7 @@
 
 #include "array.hpp"
 #include "utilities.hpp"
-#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -208,10 +208,177 @@ void ArrayTest::testArrayFunctions() {
 
 }
 
+void ArrayTest::testOperationsOnTemporaries() {
+
+    BOOST_TEST_MESSAGE("Testing array operations on temporaries...");
+
+    const Size n = 7;
+    Array a(n), b(n), c(n), d(n);
+    for (Size i=0; i<n; ++i) {
+        a[i] = std::sin(Real(i))+1.1;
+        b[i] = std::cos(Real(i))+1.3;
+        c[i] = 0.5*i+0.2;
+        d[i] = 2.0-0.1*i;
+    }
+    const Real x = 1.7;
+
+    // each expression is compared with the same operations
+    // performed element by element
+    Array results[] = {
+        a*b + c*d,
+        a*b - c,
+        a - c*d,
+        (a+b) * (c-d),
+        a * (b+c),
+        (a-b) / d,
+        a / (b+c),
+        (a+b) / (c+d),
+        -(a*b),
+        (a*b) + x,
+        x + (a*b),
+        (a*b) - x,
+        x - (a*b),
+        (a*b) * x,
+        x * (a*b),
+        (a*b) / x,
+        x / (a*b),
+        Abs(a-b),
+        Sqrt(a*b),
+        Log(a*b),
+        Exp(a-b),
+        Pow(a*b, x)
+    };
+    const Size cases = LENGTH(results);
+
+    for (Size i=0; i<n; ++i) {
+        Real expected[] = {
+            a[i]*b[i] + c[i]*d[i],
+            a[i]*b[i] - c[i],
+            a[i] - c[i]*d[i],
+            (a[i]+b[i]) * (c[i]-d[i]),
+            a[i] * (b[i]+c[i]),
+            (a[i]-b[i]) / d[i],
+            a[i] / (b[i]+c[i]),
+            (a[i]+b[i]) / (c[i]+d[i]),
+            -(a[i]*b[i]),
+            (a[i]*b[i]) + x,
+            x + (a[i]*b[i]),
+            (a[i]*b[i]) - x,
+            x - (a[i]*b[i]),
+            (a[i]*b[i]) * x,
+            x * (a[i]*b[i]),
+            (a[i]*b[i]) / x,
+            x / (a[i]*b[i]),
+            std::fabs(a[i]-b[i]),
+            std::sqrt(a[i]*b[i]),
+            std::log(a[i]*b[i]),
+            std::exp(a[i]-b[i]),
+            std::pow(a[i]*b[i], x)
+        };
+        for (Size j=0; j<cases; ++j) {
+            if (results[j].size() != n || results[j][i] != expected[j])
+                BOOST_ERROR("failed to reproduce expression #" << j
+                            << " at index " << i
+                            << "\n    calculated: " << results[j][i]
+                            << "\n    expected:   " << expected[j]);
+        }
+    }
+
+    // named arrays are not modified...
+    Array stored = a*b;
+    Array r1 = stored + c*d, r2 = c*d - stored;
+    for (Size i=0; i<n; ++i) {
+        Real expected1 = a[i]*b[i] + c[i]*d[i],
+             expected2 = c[i]*d[i] - a[i]*b[i];
+        if (stored[i] != a[i]*b[i] || r1[i] != expected1
+            || r2[i] != expected2)
+            BOOST_ERROR("named array modified by operation "
+                        "on temporary at index " << i);
+    }
+    // ...while a named Disposable is emptied by its first use, as
+    // documented; this can't be detected in C++03
+    Disposable<Array> named = a*b;
+    Array r3 = named + c;
+    if (r3.size() != n || !named.empty())
+        BOOST_ERROR("named Disposable not reused by first operation");
+
+    // the storage of the temporary is reused
+    Array t = a;
+    const Real* storage = t.begin();
+    Array r = Disposable<Array>(t) + b;
+    if (r.begin() != storage)
+        BOOST_ERROR("storage of temporary not reused");
+
+    // sizes are still checked
+    BOOST_CHECK_THROW(a*b + Array(n+1), Error);
+    BOOST_CHECK_THROW(Array(n+1) - a*b, Error);
+}
+
+void ArrayTest::testStorage() {
+
+    BOOST_TEST_MESSAGE("Testing array storage...");
+
+    // short arrays are stored inline, longer ones on the heap; all
+    // combinations are exercised by copies and swaps
+    Size sizes[] = { 0, 1, 4, 5, 100 };
+    const Size n = LENGTH(sizes);
+
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            Array a(sizes[i], 1.0, 1.0), b(sizes[j], -1.0, -1.0);
+            const Array a0(a), b0(b);
+
+            a.swap(b);
+            if (a != b0 || b != a0)
+                BOOST_ERROR("failed to swap arrays of size "
+                            << sizes[i] << " and " << sizes[j]);
+
+            a = a0;
+            b = b0;
+            Array c = b;
+            b = Disposable<Array>(a);
+            if (b != a0 || !a.empty())
+                BOOST_ERROR("failed to move array of size " << sizes[i]
+                            << " into array of size " << sizes[j]);
+
+            b = c;
+            if (b != b0 || c != b0)
+                BOOST_ERROR("failed to assign array of size " << sizes[j]
+                            << " to array of size " << sizes[i]);
+
+            std::vector<Real> v(b0.begin(), b0.end());
+            Array d(v.begin(), v.end());
+            if (d != b0)
+                BOOST_ERROR("failed to build array of size " << sizes[j]
+                            << " from iterators");
+        }
+    }
+
+    // heap storage is aligned
+    const std::size_t alignment = 64;
+    for (Size i=0; i<n; ++i) {
+        Array a(sizes[i]);
+        if (sizes[i] > 4 &&
+            reinterpret_cast<std::size_t>(a.begin()) % alignment != 0)
+            BOOST_ERROR("array of size " << sizes[i] << " not aligned");
+        Matrix m(sizes[i], 3);
+        if (!m.empty() &&
+            reinterpret_cast<std::size_t>(m.begin()) % alignment != 0)
+            BOOST_ERROR(sizes[i] << "x3 matrix not aligned");
+    }
+
+    // construction dispatched from integer arguments
+    Array e(3, 4);
+    if (e != Array(3, 4.0))
+        BOOST_ERROR("failed to build array from integers: " << e);
+}
+
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testOperationsOnTemporaries));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testStorage));
     return suite;
 }
 
@@ -29,6 +29,8 @@ class ArrayTest {
   public:
     static void testConstruction();
     static void testArrayFunctions();
+    static void testOperationsOnTemporaries();
+    static void testStorage();
     static boost::unit_test_framework::test_suite* suite();
 };
 
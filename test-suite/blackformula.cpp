@@ -117,6 +117,181 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+void BlackFormulaTest::testVectorisedFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing Black and Bachelier formulas on arrays...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0100};
+    Real forwardValues[] = {0.0050, 0.0200, 0.0500};
+    Real strikeValues[] = {-0.0050, 0.0000, 0.0100, 0.0200, 0.0500, 0.1000};
+    Real stdDevValues[] = {0.00, 0.10, 0.30, 1.00};
+    Real discountValues[] = {1.00, 0.80};
+
+    Real tol = 1.0e-14;
+
+    for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+        for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+            Option::Type type = types[i1];
+            Real displacement = displacements[i2];
+
+            std::vector<Real> strikes, forwards, stdDevs, discounts;
+            for (Size i3 = 0; i3 < LENGTH(forwardValues); ++i3)
+              for (Size i4 = 0; i4 < LENGTH(strikeValues); ++i4)
+                for (Size i5 = 0; i5 < LENGTH(stdDevValues); ++i5)
+                  for (Size i6 = 0; i6 < LENGTH(discountValues); ++i6) {
+                      if (strikeValues[i4] + displacement >= 0.0) {
+                          strikes.push_back(strikeValues[i4]);
+                          forwards.push_back(forwardValues[i3]);
+                          stdDevs.push_back(stdDevValues[i5]);
+                          discounts.push_back(discountValues[i6]);
+                      }
+                  }
+
+            std::vector<Real> black =
+                blackFormula(type, strikes, forwards, stdDevs, discounts,
+                             displacement);
+            std::vector<Real> blackVega =
+                blackFormulaStdDevDerivative(strikes, forwards, stdDevs,
+                                             discounts, displacement);
+            std::vector<Real> bachelier =
+                bachelierBlackFormula(type, strikes, forwards,
+                                      stdDevs, discounts);
+            std::vector<Real> bachelierVega =
+                bachelierBlackFormulaStdDevDerivative(strikes, forwards,
+                                                      stdDevs, discounts);
+
+            std::vector<Real> impliedStrikes, impliedForwards, prices,
+                              impliedDiscounts, expected;
+
+            for (Size i=0; i<strikes.size(); ++i) {
+                Real expectedBlack =
+                    blackFormula(type, strikes[i], forwards[i], stdDevs[i],
+                                 discounts[i], displacement);
+                Real expectedBlackVega =
+                    blackFormulaStdDevDerivative(strikes[i], forwards[i],
+                                                 stdDevs[i], discounts[i],
+                                                 displacement);
+                Real expectedBachelier =
+                    bachelierBlackFormula(type, strikes[i], forwards[i],
+                                          stdDevs[i], discounts[i]);
+                Real expectedBachelierVega =
+                    bachelierBlackFormulaStdDevDerivative(strikes[i],
+                                                          forwards[i],
+                                                          stdDevs[i],
+                                                          discounts[i]);
+                if (std::fabs(black[i] - expectedBlack) > tol
+                    || std::fabs(blackVega[i] - expectedBlackVega) > tol
+                    || std::fabs(bachelier[i] - expectedBachelier) > tol
+                    || std::fabs(bachelierVega[i]
+                                 - expectedBachelierVega) > tol)
+                    BOOST_ERROR("array formulas differ from scalar ones for "
+                                << type
+                                << " displacement=" << displacement
+                                << " forward=" << forwards[i]
+                                << " strike=" << strikes[i]
+                                << " discount=" << discounts[i]
+                                << " stddev=" << stdDevs[i]
+                                << std::setprecision(16)
+                                << "\n    Black:           " << black[i]
+                                << " (expected " << expectedBlack << ")"
+                                << "\n    Black vega:      " << blackVega[i]
+                                << " (expected " << expectedBlackVega << ")"
+                                << "\n    Bachelier:       " << bachelier[i]
+                                << " (expected " << expectedBachelier << ")"
+                                << "\n    Bachelier vega:  "
+                                << bachelierVega[i]
+                                << " (expected " << expectedBachelierVega
+                                << ")");
+
+                // deep in-the-money options have no meaningful
+                // time value to invert
+                Real intrinsic = discounts[i] *
+                    std::max((forwards[i]-strikes[i])*type, Real(0.0));
+                if (stdDevs[i] > 0.0
+                    && strikes[i] + displacement > 0.0
+                    && black[i] - intrinsic > 1.0e-6) {
+                    impliedStrikes.push_back(strikes[i]);
+                    impliedForwards.push_back(forwards[i]);
+                    prices.push_back(black[i]);
+                    impliedDiscounts.push_back(discounts[i]);
+                    expected.push_back(
+                        blackFormulaImpliedStdDev(type, strikes[i],
+                                                  forwards[i], black[i],
+                                                  discounts[i],
+                                                  displacement));
+                }
+            }
+
+            std::vector<Real> implied =
+                blackFormulaImpliedStdDev(type, impliedStrikes,
+                                          impliedForwards, prices,
+                                          impliedDiscounts, displacement);
+            for (Size i=0; i<implied.size(); ++i) {
+                if (std::fabs(implied[i] - expected[i]) > tol)
+                    BOOST_ERROR("array implied std dev differs from "
+                                "scalar one for " << type
+                                << " displacement=" << displacement
+                                << " forward=" << impliedForwards[i]
+                                << " strike=" << impliedStrikes[i]
+                                << " price=" << prices[i]
+                                << std::setprecision(16)
+                                << "\n    calculated: " << implied[i]
+                                << "\n    expected:   " << expected[i]);
+            }
+        }
+    }
+}
+
+void BlackFormulaTest::testImpliedStdDevAccuracy() {
+
+    BOOST_TEST_MESSAGE("Testing Black implied std dev accuracy...");
+
+    Real displacements[] = {0.0000, 0.0100};
+    Real forward = 0.0300;
+    Real logMoneyness[] = {-6.0, -4.0, -2.0, -1.0, -0.5, -0.1, -0.01, 0.0,
+                           0.01, 0.1, 0.5, 1.0, 2.0, 4.0, 6.0};
+    Real stdDevs[] = {0.005, 0.01, 0.05, 0.10, 0.20, 0.50, 1.00,
+                      2.00, 3.00, 5.00};
+    Real discount = 0.90;
+
+    // limited by the accuracy of the cumulative normal in the tails
+    Real tol = 1.0e-9;
+
+    for (Size i=0; i<LENGTH(displacements); ++i) {
+        Real displacement = displacements[i];
+        for (Size j=0; j<LENGTH(logMoneyness); ++j) {
+            Real strike = (forward+displacement)*std::exp(logMoneyness[j])
+                - displacement;
+            // the out-of-the-money option is used so that the price
+            // is not affected by cancellation errors
+            Option::Type type =
+                strike >= forward ? Option::Call : Option::Put;
+            for (Size k=0; k<LENGTH(stdDevs); ++k) {
+                Real stdDev = stdDevs[k];
+                Real price = blackFormula(type, strike, forward, stdDev,
+                                          discount, displacement);
+                // below this, the price carries no information on stdDev
+                if (price < 1.0e-200)
+                    continue;
+                Real implied = blackFormulaImpliedStdDev(
+                    type, strike, forward, price, discount, displacement,
+                    Null<Real>(), 1.0e-14);
+                if (std::fabs(implied - stdDev) > tol*stdDev)
+                    BOOST_ERROR("failed to recover Black std dev for "
+                                << type
+                                << " displacement=" << displacement
+                                << " forward=" << forward
+                                << " strike=" << strike
+                                << " price=" << price
+                                << std::setprecision(16)
+                                << "\n    calculated: " << implied
+                                << "\n    expected:   " << stdDev);
+            }
+        }
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +299,10 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testVectorisedFormulas));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testImpliedStdDevAccuracy));
 
     return suite;
 }
@@ -165,6 +165,76 @@ void BondTest::testYield() {
     }
 }
 
+void BondTest::testBatchYields() {
+
+    BOOST_TEST_MESSAGE("Testing batch calculation of bond yields...");
+
+    CommonVars vars;
+
+    Real tolerance = 1.0e-7;
+
+    Integer issueMonths[] = { -24, -12, 0, 12 };
+    Integer lengths[] = { 3, 10, 20 };
+    Natural settlementDays = 3;
+    Real coupons[] = { 0.02, 0.05, 0.08 };
+    DayCounter bondDayCount = Thirty360();
+    Rate yields[] = { 0.03, 0.04, 0.05, 0.06, 0.07 };
+    Compounding compounding[] = { Compounded, Continuous };
+
+    std::vector<shared_ptr<Bond> > bonds;
+    std::vector<Rate> expected;
+    for (Size i=0; i<LENGTH(issueMonths); i++) {
+        for (Size j=0; j<LENGTH(lengths); j++) {
+            for (Size k=0; k<LENGTH(coupons); k++) {
+                Date issue = vars.calendar.advance(vars.today,
+                                                   issueMonths[i], Months);
+                Date maturity = vars.calendar.advance(issue,
+                                                      lengths[j], Years);
+                Schedule sch(issue, maturity, Period(Semiannual),
+                             vars.calendar, Unadjusted, Unadjusted,
+                             DateGeneration::Backward, false);
+                bonds.push_back(shared_ptr<Bond>(
+                    new FixedRateBond(settlementDays, vars.faceAmount, sch,
+                                      std::vector<Rate>(1, coupons[k]),
+                                      bondDayCount, ModifiedFollowing,
+                                      100.0, issue)));
+                expected.push_back(yields[bonds.size() % LENGTH(yields)]);
+            }
+        }
+    }
+
+    for (Size n=0; n<LENGTH(compounding); n++) {
+        std::vector<Real> prices(bonds.size());
+        for (Size i=0; i<bonds.size(); i++)
+            prices[i] = BondFunctions::cleanPrice(*bonds[i], expected[i],
+                                                  bondDayCount,
+                                                  compounding[n],
+                                                  Semiannual);
+
+        std::vector<Rate> calculated =
+            BondFunctions::yields(bonds, prices, bondDayCount,
+                                  compounding[n], Semiannual);
+
+        for (Size i=0; i<bonds.size(); i++) {
+            Rate single = BondFunctions::yield(*bonds[i], prices[i],
+                                               bondDayCount, compounding[n],
+                                               Semiannual);
+            if (std::fabs(calculated[i]-expected[i]) > tolerance
+                || std::fabs(calculated[i]-single) > tolerance) {
+                BOOST_ERROR("batch yield calculation failed:"
+                            << "\n    maturity: "
+                            << bonds[i]->maturityDate()
+                            << "\n    price:    " << prices[i]
+                            << "\n    yield:    " << io::rate(expected[i])
+                            << (compounding[n] == Compounded ?
+                                " compounded" : " continuous")
+                            << "\n    batch:    " << io::rate(calculated[i])
+                            << "\n    single:   " << io::rate(single));
+            }
+        }
+    }
+}
+
 void BondTest::testAtmRate() {
 
     BOOST_TEST_MESSAGE("Testing consistency of bond price/ATM rate calculation...");
@@ -1383,6 +1453,7 @@ test_suite* BondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bond tests");
 
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testYield));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatchYields));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testAtmRate));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testZspread));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testTheoretical));
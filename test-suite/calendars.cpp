@@ -1783,6 +1783,210 @@ void CalendarTest::testBusinessDaysBetween() {
 }
 
 
+void CalendarTest::testBusinessDayTables() {
+
+    BOOST_TEST_MESSAGE("Testing consistency of tabulated business days...");
+
+    BespokeCalendar c1("c1"), c2("c2");
+    c1.addWeekend(Saturday);
+    c1.addWeekend(Sunday);
+    c2.addWeekend(Friday);
+    c1.addHoliday(Date(25,December,2015));
+    c2.addHoliday(Date(1,January,2016));
+
+    JointCalendar jh(TARGET(), c1, c2, JoinHolidays);
+    JointCalendar jb(c1, c2, JoinBusinessDays);
+
+    Date start(1,December,2015), end(31,March,2016);
+
+    for (Size k=0; k<3; ++k) {
+        for (Date d=start; d<=end; ++d) {
+            bool expectedH = TARGET().isBusinessDay(d)
+                && c1.isBusinessDay(d) && c2.isBusinessDay(d);
+            bool expectedB = c1.isBusinessDay(d) || c2.isBusinessDay(d);
+            if (jh.isBusinessDay(d) != expectedH)
+                BOOST_ERROR("inconsistent joint calendar (join holidays)"
+                            << " on " << d << " (pass " << k << ")");
+            if (jb.isBusinessDay(d) != expectedB)
+                BOOST_ERROR("inconsistent joint calendar (join business days)"
+                            << " on " << d << " (pass " << k << ")");
+        }
+
+        Calendar calendars[] = { TARGET(), c1, c2, jh, jb };
+        for (Size i=0; i<LENGTH(calendars); ++i) {
+            BigInteger count = 0;
+            for (Date d=start; d<end; ++d) {
+                Date::serial_type calculated =
+                    calendars[i].businessDaysBetween(start, d);
+                if (calculated != count)
+                    BOOST_ERROR("wrong business days between dates for "
+                                << calendars[i].name() << ":\n"
+                                << "    from:       " << start << "\n"
+                                << "    to:         " << d << "\n"
+                                << "    calculated: " << calculated << "\n"
+                                << "    expected:   " << count);
+                if (calendars[i].isBusinessDay(d))
+                    ++count;
+            }
+            Date::serial_type calculated =
+                calendars[i].businessDaysBetween(start, end, true, true);
+            if (calendars[i].isBusinessDay(end))
+                ++count;
+            if (calculated != count)
+                BOOST_ERROR("wrong business days between dates for "
+                            << calendars[i].name() << ":\n"
+                            << "    from:       " << start << "\n"
+                            << "    to:         " << end << "\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << count);
+        }
+
+        // modify the underlying calendars; the joint calendars
+        // must pick up the changes
+        if (k == 0) {
+            c2.addHoliday(Date(15,February,2016));
+            c1.removeHoliday(Date(25,December,2015));
+            if (jh.isBusinessDay(Date(15,February,2016)))
+                BOOST_ERROR("added holiday not seen by joint calendar");
+        } else if (k == 1) {
+            c1.addWeekend(Wednesday);
+            if (jh.isBusinessDay(Date(17,February,2016)))
+                BOOST_ERROR("added weekend not seen by joint calendar");
+        }
+    }
+
+    // calendars whose rules are not defined over the whole date
+    // range are not tabulated and keep their behavior
+    Calendar moex = Russia(Russia::MOEX);
+    if (!moex.isBusinessDay(Date(11,January,2016)))
+        BOOST_ERROR(Date(11,January,2016)
+                    << " erroneously detected as holiday for MOEX");
+    BOOST_CHECK_THROW(moex.isBusinessDay(Date(11,January,2010)), Error);
+}
+
+
+void CalendarTest::testConcurrentBusinessDayTables() {
+
+    BOOST_TEST_MESSAGE("Testing business-day tables "
+                       "under concurrent holiday changes...");
+
+    BespokeCalendar c1("c1");
+    c1.addWeekend(Saturday);
+    c1.addWeekend(Sunday);
+    JointCalendar jh(TARGET(), c1, JoinHolidays);
+
+    Date start(1,January,2016), end(31,December,2016);
+    // only the business-day status of this date changes
+    Date changed(15,June,2016);
+
+    std::vector<bool> expectedC, expectedJ;
+    for (Date d=start; d<=end; ++d) {
+        expectedC.push_back(c1.isBusinessDay(d));
+        expectedJ.push_back(jh.isBusinessDay(d));
+    }
+    BigInteger businessDays = jh.businessDaysBetween(start, end);
+
+    // task 0 adds and removes a holiday while the others read the
+    // tables; if OpenMP is not enabled, the tasks run in sequence.
+    const long tasks = 8;
+    const Size iterations = 100;
+    std::vector<Size> errors(tasks, 0);
+
+    #pragma omp parallel for default(shared)
+    for (long task=0; task<tasks; ++task) {
+        for (Size k=0; k<iterations; ++k) {
+            if (task == 0) {
+                c1.addHoliday(changed);
+                c1.removeHoliday(changed);
+            } else {
+                Size i = 0;
+                for (Date d=start; d<=end; ++d, ++i) {
+                    if (d == changed)
+                        continue;
+                    if (c1.isBusinessDay(d) != expectedC[i]
+                        || jh.isBusinessDay(d) != expectedJ[i])
+                        ++errors[task];
+                }
+                BigInteger n = jh.businessDaysBetween(start, end);
+                if (n != businessDays && n != businessDays-1)
+                    ++errors[task];
+            }
+        }
+    }
+
+    for (long task=0; task<tasks; ++task) {
+        if (errors[task] != 0)
+            BOOST_ERROR(errors[task] << " inconsistent results in task "
+                        << task);
+    }
+
+    // after the last removal, the date is a business day again
+    if (!c1.isBusinessDay(changed) || !jh.isBusinessDay(changed))
+        BOOST_ERROR("removed holiday still seen after concurrent changes");
+    if (jh.businessDaysBetween(start, end) != businessDays)
+        BOOST_ERROR("wrong business days between dates "
+                    "after concurrent changes");
+}
+
+
+void CalendarTest::testHolidayVersions() {
+
+    BOOST_TEST_MESSAGE("Testing holiday versions of calendars...");
+
+    BespokeCalendar c1("c1"), c2("c2");
+    c1.addWeekend(Saturday);
+    c1.addWeekend(Sunday);
+    c2.addWeekend(Saturday);
+    c2.addWeekend(Sunday);
+    JointCalendar j1(TARGET(), c1), j2(TARGET(), c2);
+
+    Calendar copy = c1;
+    if (!copy.sharesHolidaysWith(c1))
+        BOOST_ERROR("copied calendar doesn't share holidays");
+    if (c1.sharesHolidaysWith(c2))
+        BOOST_ERROR("distinct bespoke calendars share holidays");
+
+    Size v1 = c1.holidayVersion(), v2 = c2.holidayVersion(),
+         vj1 = j1.holidayVersion(), vj2 = j2.holidayVersion(),
+         vt = TARGET().holidayVersion();
+
+    // 15 June 2016 is a Wednesday
+    c1.addHoliday(Date(15,June,2016));
+    if (c1.holidayVersion() == v1)
+        BOOST_ERROR("holiday version unchanged after adding a holiday");
+    if (j1.holidayVersion() == vj1)
+        BOOST_ERROR("holiday version of joint calendar unchanged "
+                    "after adding a holiday to its components");
+    if (j1.isBusinessDay(Date(15,June,2016)))
+        BOOST_ERROR("added holiday not seen by joint calendar");
+    // calendars not depending on the modified one are not affected
+    if (c2.holidayVersion() != v2 || j2.holidayVersion() != vj2
+        || TARGET().holidayVersion() != vt)
+        BOOST_ERROR("holiday version changed for unrelated calendars");
+
+    v1 = c1.holidayVersion();
+    vj1 = j1.holidayVersion();
+    j1.addHoliday(Date(16,June,2016));
+    if (j1.holidayVersion() == vj1)
+        BOOST_ERROR("holiday version unchanged after adding a holiday "
+                    "to joint calendar");
+    if (c1.holidayVersion() != v1)
+        BOOST_ERROR("holiday version of component changed after adding "
+                    "a holiday to joint calendar");
+
+    vj1 = j1.holidayVersion();
+    c1.removeHoliday(Date(15,June,2016));
+    if (j1.holidayVersion() == vj1)
+        BOOST_ERROR("holiday version of joint calendar unchanged "
+                    "after removing a holiday from its components");
+    if (!j1.isBusinessDay(Date(15,June,2016)))
+        BOOST_ERROR("removed holiday still seen by joint calendar");
+    if (j1.isBusinessDay(Date(16,June,2016)))
+        BOOST_ERROR("holiday added to joint calendar lost after "
+                    "change to its components");
+}
+
+
 void CalendarTest::testBespokeCalendars() {
 
     BOOST_TEST_MESSAGE("Testing bespoke calendars...");
@@ -1934,6 +2138,10 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayTables));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &CalendarTest::testConcurrentBusinessDayTables));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testHolidayVersions));
 
     return suite;
 }
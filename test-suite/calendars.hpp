@@ -60,6 +60,9 @@ class CalendarTest {
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
+    static void testBusinessDayTables();
+    static void testConcurrentBusinessDayTables();
+    static void testHolidayVersions();
 
     static boost::unit_test_framework::test_suite* suite();
 };
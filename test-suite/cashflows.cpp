@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -28,6 +29,8 @@
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/settings.hpp>
@@ -309,6 +312,285 @@ void CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth() {
                             "got " << lastCoupon->referencePeriodEnd());
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing compiled-leg analytics...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2017);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = today + 2;
+
+    boost::shared_ptr<SimpleQuote> forecastRate(new SimpleQuote(0.02));
+    Handle<YieldTermStructure> forecastCurve(
+                                  flatRate(today, forecastRate, Actual360()));
+    boost::shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(today, 0.015, Actual365Fixed());
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months,
+                                                    forecastCurve));
+    index->addFixing(Date(19, January, 2017), 0.0135);
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(23, January, 2017)).to(Date(23, January, 2027))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing);
+
+    Leg fixedLeg = FixedRateLeg(schedule)
+        .withNotionals(100.0)
+        .withCouponRates(0.025, Thirty360())
+        .withExCouponPeriod(7*Days, TARGET(), Following);
+    fixedLeg.push_back(boost::shared_ptr<CashFlow>(
+                       new SimpleCashFlow(100.0, schedule.endDate())));
+    Leg floatingLeg = IborLeg(schedule, index)
+        .withNotionals(100.0)
+        .withSpreads(0.001);
+
+    InterestRate yields[] = {
+        InterestRate(0.03, ActualActual(ActualActual::ISMA),
+                     Compounded, Semiannual),
+        InterestRate(0.03, Actual365Fixed(), Continuous, NoFrequency),
+        InterestRate(0.03, Actual360(), SimpleThenCompounded, Annual)
+    };
+    Date settlementDates[] = { settlement, Date(16, July, 2017) };
+
+    Real tolerance = 1.0e-10;
+
+    #define CHECK_COMPILED_LEG(leg_name, what, calculated, expected) \
+    if (std::fabs((calculated) - (expected)) > tolerance) { \
+        BOOST_ERROR("failed to reproduce " << what \
+                    << " of " << leg_name << " leg" \
+                    << "\n    settlement: " << settlementDate \
+                    << std::setprecision(12) \
+                    << "\n    calculated: " << (calculated) \
+                    << "\n    expected:   " << (expected)); \
+    }
+
+    for (Size n=0; n<2; ++n) {
+        const Leg& leg = n == 0 ? fixedLeg : floatingLeg;
+        std::string legName = n == 0 ? "fixed" : "floating";
+        CompiledLeg compiled(leg);
+
+        for (Size k=0; k<LENGTH(settlementDates); ++k) {
+            Date settlementDate = settlementDates[k];
+
+            Real npv, bps;
+            compiled.npvbps(*discountCurve, false, settlementDate,
+                            settlementDate, npv, bps);
+            CHECK_COMPILED_LEG(legName, "NPV", npv,
+                               CashFlows::npv(leg, *discountCurve, false,
+                                              settlementDate));
+            CHECK_COMPILED_LEG(legName, "BPS", bps,
+                               CashFlows::bps(leg, *discountCurve, false,
+                                              settlementDate));
+            CHECK_COMPILED_LEG(legName, "NPV at today's date",
+                               compiled.npv(*discountCurve, true,
+                                            settlementDate, today),
+                               CashFlows::npv(leg, *discountCurve, true,
+                                              settlementDate, today));
+
+            for (Size j=0; j<LENGTH(yields); ++j) {
+                const InterestRate& y = yields[j];
+                CHECK_COMPILED_LEG(legName, "yield NPV",
+                                   compiled.npv(y, false, settlementDate),
+                                   CashFlows::npv(leg, y, false,
+                                                  settlementDate));
+                CHECK_COMPILED_LEG(legName, "simple duration",
+                                   compiled.duration(y, Duration::Simple,
+                                                     false, settlementDate),
+                                   CashFlows::duration(leg, y,
+                                                       Duration::Simple,
+                                                       false,
+                                                       settlementDate));
+                CHECK_COMPILED_LEG(legName, "modified duration",
+                                   compiled.duration(y, Duration::Modified,
+                                                     false, settlementDate),
+                                   CashFlows::duration(leg, y,
+                                                       Duration::Modified,
+                                                       false,
+                                                       settlementDate));
+                if (y.compounding() == Compounded)
+                    CHECK_COMPILED_LEG(legName, "Macaulay duration",
+                                       compiled.duration(y,
+                                                         Duration::Macaulay,
+                                                         false,
+                                                         settlementDate),
+                                       CashFlows::duration(leg, y,
+                                                           Duration::Macaulay,
+                                                           false,
+                                                           settlementDate));
+                CHECK_COMPILED_LEG(legName, "convexity",
+                                   compiled.convexity(y, false,
+                                                      settlementDate),
+                                   CashFlows::convexity(leg, y, false,
+                                                        settlementDate));
+
+                CHECK_COMPILED_LEG(legName, "z-spreaded NPV",
+                                   compiled.npv(*discountCurve, 0.005,
+                                                y.dayCounter(),
+                                                y.compounding(),
+                                                y.frequency(), false,
+                                                settlementDate),
+                                   CashFlows::npv(leg, discountCurve, 0.005,
+                                                  y.dayCounter(),
+                                                  y.compounding(),
+                                                  y.frequency(), false,
+                                                  settlementDate));
+                // the implied z-spread must reprice the leg
+                Real price = CashFlows::npv(leg, y, false, settlementDate);
+                Spread z = compiled.zSpread(price, *discountCurve,
+                                            y.dayCounter(), y.compounding(),
+                                            y.frequency(), false,
+                                            settlementDate);
+                Real repriced = CashFlows::npv(leg, discountCurve, z,
+                                               y.dayCounter(),
+                                               y.compounding(),
+                                               y.frequency(), false,
+                                               settlementDate);
+                if (std::fabs(repriced - price) > 1.0e-6)
+                    BOOST_ERROR("failed to reprice " << legName << " leg "
+                                "with implied z-spread"
+                                << "\n    settlement: " << settlementDate
+                                << std::setprecision(12)
+                                << "\n    z-spread:   " << z
+                                << "\n    price:      " << price
+                                << "\n    repriced:   " << repriced);
+            }
+        }
+
+        // the snapshot must be retaken when the coupons change
+        Date settlementDate = settlement;
+        Real oldNpv = compiled.npv(*discountCurve, false, settlementDate);
+        forecastRate->setValue(0.03);
+        Real newNpv = compiled.npv(*discountCurve, false, settlementDate);
+        CHECK_COMPILED_LEG(legName, "NPV after forecast change", newNpv,
+                           CashFlows::npv(leg, *discountCurve, false,
+                                          settlementDate));
+        if (n == 1 && newNpv == oldNpv)
+            BOOST_ERROR("compiled floating leg not updated "
+                        "after forecast change");
+        forecastRate->setValue(0.02);
+    }
+
+    #undef CHECK_COMPILED_LEG
+}
+
+void CashFlowsTest::testCompiledLegWithPastFixings() {
+    BOOST_TEST_MESSAGE("Testing compiled leg of seasoned floater "
+                       "without past fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2017);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = today + 2;
+
+    Handle<YieldTermStructure> forecastCurve(
+                                       flatRate(today, 0.02, Actual360()));
+    boost::shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(today, 0.015, Actual365Fixed());
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months,
+                                                    forecastCurve));
+    // the fixing of the current coupon is the only one stored
+    index->addFixing(Date(19, January, 2017), 0.0135);
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(23, January, 2014)).to(Date(23, January, 2024))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing);
+    Leg leg = IborLeg(schedule, index)
+        .withNotionals(100.0)
+        .withSpreads(0.001);
+
+    CompiledLeg compiled(leg);
+    InterestRate y(0.03, ActualActual(ActualActual::ISMA),
+                   Compounded, Semiannual);
+
+    Real tolerance = 1.0e-10;
+    try {
+        Real npv, bps;
+        compiled.npvbps(*discountCurve, false, settlement, settlement,
+                        npv, bps);
+        Real expected = CashFlows::npv(leg, *discountCurve, false,
+                                       settlement);
+        if (std::fabs(npv - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce NPV of seasoned floater"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << npv
+                        << "\n    expected:   " << expected);
+        Real yieldNpv = compiled.npv(y, false, settlement);
+        expected = CashFlows::npv(leg, y, false, settlement);
+        if (std::fabs(yieldNpv - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce yield NPV of seasoned floater"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << yieldNpv
+                        << "\n    expected:   " << expected);
+        compiled.zSpread(yieldNpv, *discountCurve, y.dayCounter(),
+                         y.compounding(), y.frequency(), false,
+                         settlement);
+    } catch (std::exception& e) {
+        BOOST_ERROR("failed to use compiled leg of seasoned floater:\n    "
+                    << e.what());
+    }
+
+    // the amounts of all coupons require the missing fixings
+    BOOST_CHECK_THROW(compiled.amounts(), Error);
+}
+
+void CashFlowsTest::testZSpreadWithPastFixings() {
+    BOOST_TEST_MESSAGE("Testing z-spread of seasoned floater "
+                       "without past fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2017);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = today + 2;
+
+    Handle<YieldTermStructure> forecastCurve(
+                                       flatRate(today, 0.02, Actual360()));
+    boost::shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(today, 0.015, Actual365Fixed());
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months,
+                                                    forecastCurve));
+    // the fixing of the current coupon is the only one stored
+    index->addFixing(Date(19, January, 2017), 0.0135);
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(23, January, 2014)).to(Date(23, January, 2024))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing);
+    Leg leg = IborLeg(schedule, index)
+        .withNotionals(100.0)
+        .withSpreads(0.001);
+
+    Spread expected = 0.005;
+    Real price = CashFlows::npv(leg, discountCurve, expected,
+                                Actual365Fixed(), Continuous, NoFrequency,
+                                false, settlement);
+    try {
+        Spread calculated =
+            CashFlows::zSpread(leg, price, discountCurve,
+                               Actual365Fixed(), Continuous, NoFrequency,
+                               false, settlement);
+        if (std::fabs(calculated - expected) > 1.0e-8)
+            BOOST_ERROR("failed to reproduce z-spread of seasoned floater"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    } catch (std::exception& e) {
+        BOOST_ERROR("failed to calculate z-spread of seasoned floater:\n    "
+                    << e.what());
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -321,6 +603,11 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularFirstCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &CashFlowsTest::testCompiledLegWithPastFixings));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &CashFlowsTest::testZSpreadWithPastFixings));
     return suite;
 }
 
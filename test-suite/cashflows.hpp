@@ -30,6 +30,9 @@ class CashFlowsTest {
     static void testNullFixingDays();
     static void testIrregularFirstCouponReferenceDatesAtEndOfMonth();
     static void testIrregularLastCouponReferenceDatesAtEndOfMonth();
+    static void testCompiledLeg();
+    static void testCompiledLegWithPastFixings();
+    static void testZSpreadWithPastFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
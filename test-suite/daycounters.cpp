@@ -31,6 +31,10 @@
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/russia.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/schedule.hpp>
 
 #include <iomanip>
@@ -374,6 +378,61 @@ void DayCounterTest::testBusiness252() {
     }
 }
 
+void DayCounterTest::testBusiness252WithOtherCalendars() {
+
+    BOOST_TEST_MESSAGE("Testing business/252 day counter "
+                       "with joint and non-tabulated calendars...");
+
+    BespokeCalendar bespoke("bespoke");
+    bespoke.addWeekend(Saturday);
+    bespoke.addWeekend(Sunday);
+    JointCalendar joint(Brazil(), UnitedStates(), bespoke, JoinHolidays);
+    // the rules of this calendar are only defined for a few years
+    Calendar moex = Russia(Russia::MOEX);
+
+    Date start(15,January,2013), end(15,January,2017);
+
+    for (Size k=0; k<2; ++k) {
+        // the day counters are created before the holiday is
+        // added; they must still see it
+        DayCounter dayCounters[] = { Business252(joint), Business252(moex) };
+        if (k == 1)
+            bespoke.addHoliday(Date(12,April,2016));
+
+        for (Date d1=start; d1<end; d1+=37) {
+            for (Date d2=d1; d2<=end; d2+=53) {
+                Date::serial_type jointDays = 0, moexDays = 0;
+                for (Date d=d1; d<d2; ++d) {
+                    if (Brazil().isBusinessDay(d)
+                        && UnitedStates().isBusinessDay(d)
+                        && bespoke.isBusinessDay(d))
+                        ++jointDays;
+                    if (moex.isBusinessDay(d))
+                        ++moexDays;
+                }
+                Date::serial_type expected[] = { jointDays, moexDays };
+                for (Size i=0; i<LENGTH(dayCounters); ++i) {
+                    Date::serial_type calculated =
+                        dayCounters[i].dayCount(d1, d2);
+                    if (calculated != expected[i])
+                        BOOST_ERROR("wrong business days for "
+                                    << dayCounters[i].name()
+                                    << " from " << d1 << " to " << d2
+                                    << " (pass " << k << "):\n"
+                                    << "    calculated: " << calculated << "\n"
+                                    << "    expected:   " << expected[i]);
+                    Time t = dayCounters[i].yearFraction(d1, d2);
+                    if (std::fabs(t - expected[i]/252.0) > 1.0e-12)
+                        BOOST_ERROR("wrong year fraction for "
+                                    << dayCounters[i].name()
+                                    << " from " << d1 << " to " << d2
+                                    << " (pass " << k << ")");
+                }
+            }
+        }
+    }
+}
+
 void DayCounterTest::testThirty360_BondBasis() {
 
     BOOST_TEST_MESSAGE("Testing thirty/360 day counter (Bond Basis)...");
@@ -546,6 +605,8 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testOne));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &DayCounterTest::testBusiness252WithOtherCalendars));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_BondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_EurobondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testIntraday));
@@ -34,6 +34,8 @@
 #include <ql/math/functional.hpp>
 
 #include <boost/math/distributions/non_central_chi_squared.hpp>
+#include <boost/math/special_functions/erf.hpp>
+#include <boost/timer.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -710,6 +712,157 @@ void DistributionTest::testInvCDFviaStochasticCollocation() {
     }
 }
 
+void DistributionTest::testNormalArrays() {
+
+    BOOST_TEST_MESSAGE("Testing array versions of normal distributions...");
+
+    CumulativeNormalDistribution cumulative;
+    InverseCumulativeNormal inverse;
+
+    // cumulative, against the complementary error function
+    std::vector<Real> x, y;
+    for (Real z=-37.0; z<=8.0; z+=0.001)
+        x.push_back(z);
+    y.resize(x.size());
+    cumulative(&x[0], x.size(), &y[0]);
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = 0.5*boost::math::erfc(-x[i]/M_SQRT2);
+        Real error = x[i] < 0.0 ? std::fabs(y[i]-expected)/expected
+                                : std::fabs(y[i]-expected);
+        if (error > 1.0e-12)
+            BOOST_FAIL("cumulative normal array value at " << x[i]
+                       << " differs from the expected one:"
+                       << std::scientific
+                       << "\n    calculated: " << y[i]
+                       << "\n    expected:   " << expected
+                       << "\n    error:      " << error);
+    }
+
+    // inverse cumulative, against the scalar version and after
+    // refinement; the tails are sampled more densely
+    std::vector<Real> u;
+    for (Integer k=1; k<=15; ++k) {
+        u.push_back(std::pow(10.0, -k));
+        u.push_back(1.0-std::pow(10.0, -k));
+    }
+    for (Real p=0.0001; p<1.0; p+=0.0001)
+        u.push_back(p);
+    std::vector<Real> approximated(u), refined(u.size());
+    // the buffers can be the same
+    inverse(&approximated[0], u.size(), &approximated[0]);
+    inverse(&u[0], u.size(), &refined[0], InverseCumulativeNormal::Refined);
+    for (Size i=0; i<u.size(); ++i) {
+        Real expected = inverse(u[i]);
+        if (std::fabs(approximated[i]-expected) > 1.0e-15*std::fabs(expected))
+            BOOST_FAIL("inverse cumulative normal array value at " << u[i]
+                       << " differs from the scalar one:"
+                       << std::scientific
+                       << "\n    calculated: " << approximated[i]
+                       << "\n    expected:   " << expected);
+
+        Real p = 0.5*boost::math::erfc(-refined[i]/M_SQRT2);
+        Real error = u[i] <= 0.5 ? std::fabs(p-u[i])/u[i]
+                                 : std::fabs(p-u[i]);
+        if (error > 1.0e-12)
+            BOOST_FAIL("refined inverse cumulative normal at " << u[i]
+                       << " is inaccurate:"
+                       << std::scientific
+                       << "\n    calculated: " << refined[i]
+                       << "\n    round trip: " << p
+                       << "\n    error:      " << error);
+    }
+
+    // timings, for information
+    const Size n = 1000000;
+    std::vector<Real> points(n), results(n);
+    for (Size i=0; i<n; ++i)
+        points[i] = (i+0.5)/n;
+    boost::timer timer;
+    for (Size i=0; i<n; ++i)
+        results[i] = inverse(points[i]);
+    Real scalarInverse = timer.elapsed();
+    timer.restart();
+    inverse(&points[0], n, &results[0]);
+    Real arrayInverse = timer.elapsed();
+    std::copy(results.begin(), results.end(), points.begin());
+    timer.restart();
+    for (Size i=0; i<n; ++i)
+        results[i] = cumulative(points[i]);
+    Real scalarCumulative = timer.elapsed();
+    timer.restart();
+    cumulative(&points[0], n, &results[0]);
+    Real arrayCumulative = timer.elapsed();
+    BOOST_TEST_MESSAGE("    " << n << " points:"
+                       << "\n    inverse cumulative: "
+                       << scalarInverse << " s (scalar), "
+                       << arrayInverse << " s (array)"
+                       << "\n    cumulative:         "
+                       << scalarCumulative << " s (scalar), "
+                       << arrayCumulative << " s (array)");
+}
+
+namespace {
+
+    template <class Bivariate>
+    void checkBivariateArrays(const char* tag, Real maxCorrelation) {
+
+        // the correlations cover all the branches of both algorithms
+        Real rho[] = { -1.0, -0.99, -0.925, -0.8, -0.5, -0.1, 0.0,
+                       0.2, 0.3, 0.6, 0.75, 0.9, 0.95, 0.999, 1.0 };
+
+        std::vector<Real> x, y;
+        for (Real a=-6.0; a<=6.0; a+=0.37) {
+            for (Real b=-6.0; b<=6.0; b+=0.41) {
+                x.push_back(a);
+                y.push_back(b);
+            }
+        }
+        std::vector<Real> result(x.size());
+
+        for (Size i=0; i<LENGTH(rho); ++i) {
+            if (std::fabs(rho[i]) > maxCorrelation)
+                continue;
+            Bivariate f(rho[i]);
+            f(&x[0], &y[0], x.size(), &result[0]);
+            for (Size j=0; j<x.size(); ++j) {
+                Real expected = f(x[j], y[j]);
+                if (result[j] != expected)
+                    BOOST_FAIL(tag << " bivariate cumulative distribution\n"
+                               << "    rho:        " << rho[i] << "\n"
+                               << "    x:          " << x[j] << "\n"
+                               << "    y:          " << y[j] << "\n"
+                               << std::setprecision(16)
+                               << "    array:      " << result[j] << "\n"
+                               << "    scalar:     " << expected);
+            }
+        }
+
+        // results can be stored in place of the inputs
+        Bivariate f(0.6);
+        std::vector<Real> z(x);
+        f(&z[0], &y[0], z.size(), &z[0]);
+        for (Size j=0; j<x.size(); ++j) {
+            if (z[j] != f(x[j], y[j]))
+                BOOST_FAIL(tag << " bivariate cumulative distribution "
+                           "failed in place at (" << x[j] << ", "
+                           << y[j] << ")");
+        }
+    }
+
+}
+
+void DistributionTest::testBivariateArrays() {
+
+    BOOST_TEST_MESSAGE("Testing array versions of bivariate cumulative "
+                       "normal distributions...");
+
+    // Drezner's algorithm doesn't handle |rho| = 1
+    checkBivariateArrays<BivariateCumulativeNormalDistributionDr78>(
+                                                        "Drezner 1978", 0.999);
+    checkBivariateArrays<BivariateCumulativeNormalDistributionWe04DP>(
+                                                             "West 2004", 1.0);
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -723,6 +876,8 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
                           &DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(
                    &DistributionTest::testInvCDFviaStochasticCollocation));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormalArrays));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariateArrays));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
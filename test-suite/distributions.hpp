@@ -38,6 +38,8 @@ class DistributionTest {
     static void testBivariateCumulativeStudent();
     static void testBivariateCumulativeStudentVsBivariate();
     static void testInvCDFviaStochasticCollocation();
+    static void testNormalArrays();
+    static void testBivariateArrays();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -26,9 +26,13 @@
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/experimental/math/gaussiannoncentralchisquaredpolynomial.hpp>
+#include <ql/experimental/math/multidimquadrature.hpp>
+#include <ql/experimental/math/sparsegridquadrature.hpp>
 
 #include <boost/math/distributions/non_central_chi_squared.hpp>
 
+#include <iomanip>
+
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
@@ -83,6 +87,31 @@ namespace {
             boost::math::non_central_chi_squared_distribution<Real>(1.0,1.0),x);
     }
 
+    // exp(-|x|^2) prod_i cos(x_i), whose integral over R^d is
+    // (exp(-1/4) sqrt(pi))^d
+    Real gaussianCosine(const std::vector<Real>& x) {
+        Real result = 1.0;
+        for (Size i=0; i<x.size(); ++i)
+            result *= std::exp(-x[i]*x[i]) * std::cos(x[i]);
+        return result;
+    }
+
+    Real gaussianCosine1D(Real x) {
+        return std::exp(-x*x) * std::cos(x);
+    }
+
+    Disposable<std::vector<Real> > gaussianMoments(
+                                             const std::vector<Real>& x) {
+        Real density = 1.0;
+        for (Size i=0; i<x.size(); ++i)
+            density *= std::exp(-x[i]*x[i]);
+        std::vector<Real> result(3);
+        result[0] = density;
+        result[1] = density * x[0] * x[0];
+        result[2] = gaussianCosine(x);
+        return result;
+    }
+
     template <class T>
     void testSingleJacobi(const T& I) {
         testSingle(I, "f(x) = 1",
@@ -249,6 +278,107 @@ void GaussianQuadraturesTest::testNonCentralChiSquaredSumOfNotes() {
 }
 
 
+void GaussianQuadraturesTest::testSparseGridGaussHermite() {
+     BOOST_TEST_MESSAGE(
+         "Testing sparse-grid Gauss-Hermite integration...");
+
+     boost::function<Real (const std::vector<Real>&)> f = gaussianCosine;
+     boost::function<Disposable<std::vector<Real> > (
+                              const std::vector<Real>&)> g = gaussianMoments;
+
+     // in one dimension, the grid is the Gauss-Hermite rule
+     const Size order = 12;
+     GaussHermiteIntegration gaussHermite(order);
+     SparseGridGaussHermiteIntegrator oneDim(1, order);
+     Real calculated = oneDim(f);
+     Real expected =
+         gaussHermite(std::ptr_fun<Real,Real>(gaussianCosine1D));
+     if (oneDim.size() != gaussHermite.order()
+         || std::fabs(calculated-expected) > 1.0e-14) {
+         BOOST_ERROR("failed to reproduce Gauss-Hermite rule"
+                     << "\n    nodes:      " << oneDim.size()
+                     << "\n    calculated: " << calculated
+                     << "\n    expected:   " << expected);
+     }
+
+     // same polynomial exactness as the tensor product of the
+     // rules of the same order, with fewer nodes
+     const Size level = 4;
+     SparseGridGaussHermiteIntegrator polynomialGrid(6, level);
+     Size tensorNodes = 1;
+     for (Size i=0; i<6; ++i)
+         tensorNodes *= level;
+     if (polynomialGrid.size() >= tensorNodes/10) {
+         BOOST_ERROR("too many nodes in sparse grid"
+                     << "\n    sparse grid:    " << polynomialGrid.size()
+                     << "\n    tensor product: " << tensorNodes);
+     }
+     // exp(-|x|^2) x_1^4 x_2^2, total degree 6
+     Real polynomial = 0.0;
+     for (Size i=0; i<polynomialGrid.size(); ++i) {
+         const std::vector<Real>& x = polynomialGrid.nodes()[i];
+         polynomial += polynomialGrid.weights()[i]
+             * std::exp(-std::inner_product(x.begin(), x.end(),
+                                            x.begin(), 0.0))
+             * x[0]*x[0]*x[0]*x[0]*x[1]*x[1];
+     }
+     Real exactPolynomial = 0.75*0.5*std::pow(std::sqrt(M_PI), 6.0);
+     if (std::fabs(polynomial-exactPolynomial) > 1.0e-10) {
+         BOOST_ERROR("failed to integrate polynomial exactly"
+                     << std::setprecision(12)
+                     << "\n    calculated: " << polynomial
+                     << "\n    expected:   " << exactPolynomial);
+     }
+
+     const Size dimension = 4;
+     SparseGridGaussHermiteIntegrator sparseGrid(dimension, 11);
+     GaussianQuadMultidimIntegrator tensorProduct(dimension, 11);
+
+     Real exact = std::pow(std::exp(-0.25) * std::sqrt(M_PI),
+                           static_cast<Real>(dimension));
+     calculated = sparseGrid(f);
+     Real tensor = tensorProduct.integrate<Real>(f);
+     if (std::fabs(calculated-exact) > 1.0e-7
+         || std::fabs(tensor-exact) > 1.0e-7) {
+         BOOST_ERROR("failed to integrate scalar function"
+                     << std::setprecision(12)
+                     << "\n    sparse grid:    " << calculated
+                     << "\n    tensor product: " << tensor
+                     << "\n    exact:          " << exact);
+     }
+
+     // vector integrands, accumulated in place
+     std::vector<Real> exactV(3);
+     exactV[0] = std::pow(std::sqrt(M_PI), static_cast<Real>(dimension));
+     exactV[1] = 0.5*exactV[0];
+     exactV[2] = exact;
+     std::vector<Real> sparseV = sparseGrid.integrateV(g);
+     std::vector<Real> tensorV =
+         tensorProduct.integrate<Disposable<std::vector<Real> > >(g);
+     for (Size i=0; i<exactV.size(); ++i) {
+             if (std::fabs(sparseV[i]-exactV[i]) > 1.0e-7
+             || std::fabs(tensorV[i]-exactV[i]) > 1.0e-6) {
+             BOOST_ERROR("failed to integrate vector function"
+                         << std::setprecision(12)
+                         << "\n    component:      " << i
+                         << "\n    sparse grid:    " << sparseV[i]
+                         << "\n    tensor product: " << tensorV[i]
+                         << "\n    exact:          " << exactV[i]);
+         }
+     }
+
+     // parallel evaluation must not change the results
+     SparseGridGaussHermiteIntegrator parallelGrid(dimension, 11, 0.0, true);
+     std::vector<Real> parallelV = parallelGrid.integrateV(g);
+     if (parallelGrid(f) != calculated || parallelV != sparseV) {
+         BOOST_ERROR("parallel evaluation changed the results"
+                     << std::setprecision(16)
+                     << "\n    serial:   " << calculated
+                     << "\n    parallel: " << parallelGrid(f));
+     }
+}
+
+
 test_suite* GaussianQuadraturesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Gaussian quadratures tests");
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testJacobi));
@@ -267,6 +397,8 @@ test_suite* GaussianQuadraturesTest::experimental() {
         &GaussianQuadraturesTest::testNonCentralChiSquared));
     suite->add(QUANTLIB_TEST_CASE(
         &GaussianQuadraturesTest::testNonCentralChiSquaredSumOfNotes));
+    suite->add(QUANTLIB_TEST_CASE(
+        &GaussianQuadraturesTest::testSparseGridGaussHermite));
 
     return suite;
 }
@@ -34,6 +34,7 @@ class GaussianQuadraturesTest {
     static void testTabulated();
     static void testNonCentralChiSquared();
     static void testNonCentralChiSquaredSumOfNotes();
+    static void testSparseGridGaussHermite();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
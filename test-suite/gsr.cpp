@@ -285,9 +285,79 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testGsrRollback() {
+
+    BOOST_TEST_MESSAGE("Testing GSR model rollback...");
+
+    Real modelvol = 0.01;
+    Real reversion = 0.01;
+
+    std::vector<Date> stepDates;
+    std::vector<Real> vols(1, modelvol);
+    std::vector<Real> reversions(1, reversion);
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    boost::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversions, 50.0));
+
+    // rolling back deflated zerobonds must reproduce the deflated
+    // zerobond prices at the earlier time, up to the interpolation
+    // error of the payoff (fourth order in the grid spacing)
+
+    const int gridPoints = 64;
+    const Real stdDevs = 7.0;
+    const Real tol = 1E-7;
+
+    Array z = model->yGrid(stdDevs, gridPoints);
+    Array values(z.size()), result(z.size()), single(1);
+
+    Time t = 2.0, T = 5.0, S = 10.0;
+    for (Size i = 0; i < z.size(); i++)
+        values[i] = model->zerobond(S, T, z[i]) / model->numeraire(T, z[i]);
+
+    // twice, the second time the cached kernel is used
+    for (Size r = 0; r < 2; r++) {
+        model->rollback(result, values, T, t, stdDevs, gridPoints);
+        for (Size k = 0; k < z.size(); k++) {
+            if (std::fabs(z[k]) > 3.0)
+                continue;
+            Real expected = model->zerobond(S, t, z[k]) /
+                            model->numeraire(t, z[k]);
+            if (fabs(result[k] - expected) > tol * expected)
+                BOOST_ERROR("rollback of deflated zerobond P("
+                            << T << "," << S << ") to t=" << t << ", y="
+                            << z[k] << " yields " << std::setprecision(12)
+                            << result[k] << ", expected " << expected);
+            model->rollback(single, values, T, t, stdDevs, gridPoints, true,
+                            false, Option::Call, z[k]);
+            if (fabs(single[0] - result[k]) > 1E-14)
+                BOOST_ERROR("rollback conditional on y=" << z[k] << " ("
+                            << single[0] << ") is different from "
+                            << "rollback on full grid (" << result[k]
+                            << ")");
+        }
+    }
+
+    // rolling back to more times than the cached grids can hold must
+    // leave the results unchanged
+    Array cached(result);
+    for (Size j = 1; j <= 100; j++)
+        model->rollback(result, values, T, 0.04 * j, stdDevs, gridPoints);
+    model->rollback(result, values, T, t, stdDevs, gridPoints);
+    for (Size k = 0; k < z.size(); k++) {
+        if (result[k] != cached[k])
+            BOOST_ERROR("rollback to t=" << t << ", y=" << z[k]
+                        << " yields " << std::setprecision(16) << result[k]
+                        << " after rolling back to other times, "
+                        << cached[k] << " before");
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrRollback));
     return suite;
 }
@@ -1915,6 +1915,143 @@ void HestonModelTest::testCosHestonEngine() {
     }
 }
 
+void HestonModelTest::testAnalyticGradient() {
+    BOOST_TEST_MESSAGE(
+        "Testing analytic Heston model gradient vs finite differences...");
+
+    SavedSettings backup;
+
+    const Date today = Date(22, November, 2017);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<Quote> vol(boost::make_shared<SimpleQuote>(0.25));
+
+    const boost::shared_ptr<HestonModel> model(boost::make_shared<HestonModel>(
+        boost::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.05, 1.5, 0.04, 0.5, -0.6)));
+    const boost::shared_ptr<PricingEngine> engine(
+        boost::make_shared<AnalyticHestonEngine>(model, 144));
+
+    const Period maturities[] = { Period(3, Months), Period(1, Years),
+                                  Period(5, Years) };
+    const Real strikes[] = { 70.0, 100.0, 140.0 };
+
+    const Real h = 1e-6, tolerance = 1e-5;
+    const Array params = model->params();
+
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            HestonModelHelper helper(maturities[i], calendar, s0,
+                                     strikes[j], vol, riskFreeTS, dividendTS);
+            helper.setPricingEngine(engine);
+
+            if (!helper.hasAnalyticGradient())
+                BOOST_FAIL("analytic gradient expected to be available");
+
+            Array gradient;
+            const Real value = helper.modelValueAndGradient(gradient);
+            if (std::fabs(value - helper.modelValue()) > 1e-12)
+                BOOST_ERROR("value from gradient calculation ("
+                            << value << ") differs from model value ("
+                            << helper.modelValue() << ")");
+
+            for (Size k=0; k < params.size(); ++k) {
+                Array bumped(params);
+                bumped[k] = params[k] + h;
+                model->setParams(bumped);
+                const Real up = helper.modelValue();
+                bumped[k] = params[k] - h;
+                model->setParams(bumped);
+                const Real down = helper.modelValue();
+                model->setParams(params);
+
+                const Real expected = (up - down)/(2*h);
+                if (std::fabs(gradient[k] - expected) > tolerance
+                                * std::max(1.0, std::fabs(expected))) {
+                    BOOST_ERROR("failed to reproduce finite difference "
+                                "gradient"
+                                << "\n    maturity:   " << maturities[i]
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    parameter:  " << k
+                                << "\n    analytic:   " << gradient[k]
+                                << "\n    numerical:  " << expected);
+                }
+            }
+        }
+    }
+}
+
+void HestonModelTest::testBatchPricing() {
+    BOOST_TEST_MESSAGE(
+        "Testing batch pricing of Heston engines vs single options...");
+
+    SavedSettings backup;
+
+    const Date today = Date(22, November, 2017);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonModel> model(boost::make_shared<HestonModel>(
+        boost::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.05, 1.5, 0.04, 0.5, -0.6)));
+
+    const boost::shared_ptr<AnalyticHestonEngine> analyticEngine(
+        boost::make_shared<AnalyticHestonEngine>(model, 144));
+    const boost::shared_ptr<COSHestonEngine> cosEngine(
+        boost::make_shared<COSHestonEngine>(model));
+
+    std::vector<Option::Type> types;
+    std::vector<Real> strikes;
+    std::vector<Date> exerciseDates;
+    const Period maturities[] = { Period(1, Years), Period(3, Months),
+                                  Period(5, Years) };
+    for (Size i=0; i < LENGTH(maturities); ++i) {
+        for (Real strike = 60.0; strike < 160.0; strike += 20.0) {
+            types.push_back(strike < 100.0 ? Option::Put : Option::Call);
+            strikes.push_back(strike);
+            exerciseDates.push_back(today + maturities[i]);
+        }
+    }
+
+    const Array analyticPrices =
+        analyticEngine->prices(types, strikes, exerciseDates);
+    const Array cosPrices = cosEngine->prices(types, strikes, exerciseDates);
+
+    const Real tol = 1e-10;
+    for (Size i=0; i < types.size(); ++i) {
+        VanillaOption option(
+            boost::make_shared<PlainVanillaPayoff>(types[i], strikes[i]),
+            boost::make_shared<EuropeanExercise>(exerciseDates[i]));
+
+        option.setPricingEngine(analyticEngine);
+        const Real analyticNpv = option.NPV();
+        option.setPricingEngine(cosEngine);
+        const Real cosNpv = option.NPV();
+
+        if (std::fabs(analyticNpv - analyticPrices[i]) > tol
+            || std::fabs(cosNpv - cosPrices[i]) > tol) {
+            BOOST_ERROR("failed to reproduce single option prices"
+                        << "\n    exercise date:  " << exerciseDates[i]
+                        << "\n    strike:         " << strikes[i]
+                        << "\n    analytic:       " << analyticNpv
+                        << "\n    analytic batch: " << analyticPrices[i]
+                        << "\n    cos:            " << cosNpv
+                        << "\n    cos batch:      " << cosPrices[i]);
+        }
+    }
+}
+
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1940,6 +2077,8 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
                     &HestonModelTest::testAllIntegrationMethods));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCosHestonCumulants));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCosHestonEngine));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticGradient));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBatchPricing));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -47,6 +47,8 @@ class HestonModelTest {
     static void testAllIntegrationMethods();
     static void testCosHestonCumulants();
     static void testCosHestonEngine();
+    static void testAnalyticGradient();
+    static void testBatchPricing();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
     static boost::unit_test_framework::test_suite* experimental();
 };
@@ -51,6 +51,8 @@
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/models/shortrate/calibrationhelpers/caphelper.hpp>
 
+#include <algorithm>
+
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
@@ -1748,6 +1750,114 @@ void MarkovFunctionalTest::testBermudanSwaption() {
     Settings::instance().evaluationDate() = savedEvalDate;
 }
 
+void MarkovFunctionalTest::testIncrementalTabulation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Markov functional incremental numeraire tabulation...");
+
+    const Real tol = 1E-12;
+
+    Date savedEvalDate = Settings::instance().evaluationDate();
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    Handle<YieldTermStructure> flatYts_ = flatYts();
+
+    std::vector<Period> optionTenors, swapTenors;
+    optionTenors.push_back(1 * Years);
+    optionTenors.push_back(3 * Years);
+    optionTenors.push_back(5 * Years);
+    swapTenors.push_back(1 * Years);
+    swapTenors.push_back(10 * Years);
+    swapTenors.push_back(20 * Years);
+
+    std::vector<boost::shared_ptr<SimpleQuote> > shortQuotes;
+    std::vector<std::vector<Handle<Quote> > > quotes;
+    for (Size i = 0; i < optionTenors.size(); i++) {
+        std::vector<Handle<Quote> > row;
+        for (Size j = 0; j < swapTenors.size(); j++) {
+            boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.20));
+            if (i == 0)
+                shortQuotes.push_back(q);
+            row.push_back(Handle<Quote>(q));
+        }
+        quotes.push_back(row);
+    }
+    Handle<SwaptionVolatilityStructure> vts(
+        boost::shared_ptr<SwaptionVolatilityStructure>(
+            new SwaptionVolatilityMatrix(TARGET(), ModifiedFollowing,
+                                         optionTenors, swapTenors, quotes,
+                                         Actual365Fixed())));
+
+    boost::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+
+    std::vector<Date> volStepDates;
+    std::vector<Real> vols(1, 1.0);
+
+    MarkovFunctional::ModelSettings settings =
+        MarkovFunctional::ModelSettings().withYGridPoints(32);
+
+    boost::shared_ptr<MarkovFunctional> full(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, vols, vts, expiriesCalBasket1(),
+        tenorsCalBasket1(), swapIndexBase, settings));
+    boost::shared_ptr<MarkovFunctional> incremental(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, vols, vts, expiriesCalBasket1(),
+        tenorsCalBasket1(), swapIndexBase,
+        settings.addAdjustment(
+            MarkovFunctional::ModelSettings::IncrementalTabulation)));
+
+    // the second and third scenario only change the smiles of the early
+    // expiries, in the last one nothing changes at all
+    for (Size s = 0; s < 4; s++) {
+        if (s == 1 || s == 2) {
+            for (Size j = 0; j < shortQuotes.size(); j++)
+                shortQuotes[j]->setValue(0.20 + 0.05 * s);
+        }
+        if (s == 3)
+            incremental->update();
+        for (Real t = 0.5; t < 15.0; t += 0.5) {
+            for (Real y = -3.0; y <= 3.0; y += 1.0) {
+                Real n0 = full->numeraire(t, y);
+                Real n1 = incremental->numeraire(t, y);
+                if (fabs(n0 - n1) > tol)
+                    BOOST_ERROR("numeraire at t=" << t << ", y=" << y
+                                << " with incremental tabulation ("
+                                << n1 << ") is different from "
+                                << "full tabulation (" << n0
+                                << ") in scenario " << s);
+            }
+        }
+
+        // check which calibration points were tabulated again
+        const std::vector<bool>& tabulated =
+            incremental->modelOutputs().tabulated_;
+        Size n = std::count(tabulated.begin(), tabulated.end(), true);
+        bool expected;
+        if (s == 0)
+            expected = n == tabulated.size();
+        else if (s == 3)
+            expected = n == 0;
+        else
+            expected = n > 0 && n < tabulated.size() && !tabulated.back();
+        if (!expected)
+            BOOST_ERROR(n << " out of " << tabulated.size()
+                        << " calibration points tabulated"
+                        << (tabulated.back() ? ", including the last one,"
+                                             : "")
+                        << " with incremental tabulation in scenario " << s);
+
+        const std::vector<bool>& fullyTabulated =
+            full->modelOutputs().tabulated_;
+        n = std::count(fullyTabulated.begin(), fullyTabulated.end(), true);
+        if (n != fullyTabulated.size())
+            BOOST_ERROR("calibration points skipped with full tabulation "
+                        "in scenario " << s);
+    }
+
+    Settings::instance().evaluationDate() = savedEvalDate;
+}
+
 test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
     test_suite *suite = BOOST_TEST_SUITE("Markov functional model tests");
 
@@ -1762,6 +1872,8 @@ test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
             &MarkovFunctionalTest::testCalibrationOneInstrumentSet));
         suite->add(QUANTLIB_TEST_CASE(
             &MarkovFunctionalTest::testCalibrationTwoInstrumentSets));
+        suite->add(QUANTLIB_TEST_CASE(
+            &MarkovFunctionalTest::testIncrementalTabulation));
     }
 
     if (speed == Slow) {
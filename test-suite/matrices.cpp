@@ -23,6 +23,7 @@
 #include "matrices.hpp"
 #include "utilities.hpp"
 #include <ql/math/matrix.hpp>
+#include <ql/math/comparison.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
@@ -601,6 +602,124 @@ void MatricesTest::testMoorePenroseInverse() {
 
 }
 
+void MatricesTest::testBlockedKernels() {
+
+    BOOST_TEST_MESSAGE("Testing blocked matrix products and Cholesky "
+                       "decomposition against unblocked versions...");
+
+    // with BLAS, the order of the operations can change
+    #if defined(QL_USE_BLAS)
+    const Real tol = 1.0e-12;
+    #else
+    const Real tol = 0.0;
+    #endif
+
+    MersenneTwisterUniformRng rng(1234);
+    // sizes on both sides of the block sizes
+    const Size sizes[][3] = { { 1, 1, 1 }, { 3, 5, 2 }, { 31, 64, 33 },
+                              { 65, 32, 130 }, { 130, 97, 65 } };
+    for (Size n=0; n<LENGTH(sizes); ++n) {
+        Matrix a(sizes[n][0], sizes[n][1]), b(sizes[n][1], sizes[n][2]);
+        for (Matrix::iterator i=a.begin(); i!=a.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        for (Matrix::iterator i=b.begin(); i!=b.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        Array x(a.columns()), y(a.rows());
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = rng.nextReal() - 0.5;
+        for (Size i=0; i<y.size(); ++i)
+            y[i] = rng.nextReal() - 0.5;
+
+        Matrix expected(a.rows(), b.columns(), 0.0);
+        for (Size i=0; i<a.rows(); ++i)
+            for (Size k=0; k<a.columns(); ++k)
+                for (Size j=0; j<b.columns(); ++j)
+                    expected[i][j] += a[i][k]*b[k][j];
+        Matrix calculated = a*b;
+        if (norm(calculated - expected) > tol*norm(expected)) {
+            BOOST_ERROR("matrix product of " << a.rows() << "x" << a.columns()
+                        << " and " << b.rows() << "x" << b.columns()
+                        << " matrices differs from the unblocked one"
+                        << "\n    difference: "
+                        << norm(calculated - expected));
+        }
+
+        Array expectedAx(a.rows()), expectedYa(a.columns());
+        for (Size i=0; i<a.rows(); ++i)
+            expectedAx[i] = std::inner_product(x.begin(), x.end(),
+                                               a.row_begin(i), 0.0);
+        for (Size j=0; j<a.columns(); ++j)
+            expectedYa[j] = std::inner_product(y.begin(), y.end(),
+                                               a.column_begin(j), 0.0);
+        Array ax = a*x, ya = y*a;
+        if (norm(ax - expectedAx) > tol*norm(expectedAx)
+            || norm(ya - expectedYa) > tol*norm(expectedYa)) {
+            BOOST_ERROR("matrix-vector products with a " << a.rows() << "x"
+                        << a.columns() << " matrix differ from the "
+                        "unblocked ones"
+                        << "\n    difference (Ax): " << norm(ax - expectedAx)
+                        << "\n    difference (yA): " << norm(ya - expectedYa));
+        }
+    }
+
+    // positive definite and, for the flexible decomposition,
+    // semi-definite covariance matrices
+    const Size size = 100;
+    const Size ranks[] = { 2*size, 20 };
+    for (Size n=0; n<LENGTH(ranks); ++n) {
+        Matrix f(size, ranks[n]);
+        for (Matrix::iterator i=f.begin(); i!=f.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        Matrix s = f*transpose(f);
+        bool flexible = (ranks[n] < size);
+
+        Matrix expected(size, size, 0.0);
+        for (Size i=0; i<size; i++) {
+            for (Size j=i; j<size; j++) {
+                Real sum = s[i][j];
+                for (Size k=0; k<i; k++)
+                    sum -= expected[i][k]*expected[j][k];
+                if (i == j)
+                    expected[i][i] = std::sqrt(std::max<Real>(sum, 0.0));
+                else
+                    expected[j][i] = close_enough(expected[i][i], 0.0)
+                                     ? 0.0 : sum / expected[i][i];
+            }
+        }
+        Matrix calculated = CholeskyDecomposition(s, flexible);
+        if (norm(calculated - expected) > tol*norm(expected)) {
+            BOOST_ERROR("Cholesky decomposition of rank "
+                        << std::min(ranks[n], size)
+                        << " differs from the unblocked one"
+                        << "\n    difference: "
+                        << norm(calculated - expected));
+        }
+    }
+
+    // large enough to be decomposed by LAPACK if enabled
+    Matrix f(50, 50);
+    for (Matrix::iterator i=f.begin(); i!=f.end(); ++i)
+        *i = rng.nextReal() - 0.5;
+    Matrix s = f + transpose(f);
+    SymmetricSchurDecomposition schur(s);
+    const Array& eigenValues = schur.eigenvalues();
+    const Matrix& eigenVectors = schur.eigenvectors();
+    Matrix d(50, 50, 0.0);
+    for (Size i=0; i<50; ++i) {
+        d[i][i] = eigenValues[i];
+        if (i > 0 && eigenValues[i] > eigenValues[i-1])
+            BOOST_ERROR("eigenvalues not sorted: " << eigenValues);
+        if (eigenVectors[0][i] < 0.0)
+            BOOST_ERROR("eigenvector " << i << " not normalized");
+    }
+    Matrix reconstructed = eigenVectors*d*transpose(eigenVectors);
+    if (norm(reconstructed - s) > 1.0e-12*norm(s)) {
+        BOOST_ERROR("failed to reconstruct 50x50 matrix from its "
+                    "eigenvalues and eigenvectors"
+                    << "\n    difference: " << norm(reconstructed - s));
+    }
+}
+
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
@@ -617,6 +736,7 @@ test_suite* MatricesTest::suite() {
     #endif
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskyDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testBlockedKernels));
     return suite;
 }
 
@@ -481,10 +481,65 @@ void MersenneTwisterTest::testValues() {
                    "during parallel computation");
 }
 
+void MersenneTwisterTest::testBlocksAndSkipAhead() {
+
+    BOOST_TEST_MESSAGE("Testing Mersenne twister blocks and skip-ahead...");
+
+    const unsigned long seed = 1234UL;
+    const Size n = 2000;
+
+    // blocks crossing the boundaries of the internal state
+    MersenneTwisterUniformRng rng(seed), blockRng(seed);
+    std::vector<unsigned long> values(n);
+    std::vector<Real> reals(n);
+    blockRng.nextInt32s(&values[0], 17);
+    blockRng.nextInt32s(&values[17], 1000);
+    blockRng.nextInt32s(&values[1017], n-1017);
+    for (Size i=0; i<n; ++i) {
+        unsigned long expected = rng.nextInt32();
+        if (values[i] != expected)
+            BOOST_FAIL("block value #" << i << " differs:"
+                       << "\n    calculated: " << values[i]
+                       << "\n    expected:   " << expected);
+    }
+    blockRng.nextReals(&reals[0], n);
+    for (Size i=0; i<n; ++i) {
+        Real expected = rng.nextReal();
+        if (reals[i] != expected)
+            BOOST_FAIL("block real #" << i << " differs:"
+                       << "\n    calculated: " << reals[i]
+                       << "\n    expected:   " << expected);
+    }
+
+    // skipping ahead, both by twisting and by jumping
+    BigNatural skips[] = { 0, 1, 100, 623, 624, 625, 100000, 10000000 };
+    for (Size j=0; j<LENGTH(skips); ++j) {
+        MersenneTwisterUniformRng skipped(seed), drawn(seed);
+        for (Size i=0; i<17; ++i) {
+            skipped.nextInt32();
+            drawn.nextInt32();
+        }
+        skipped.skip(skips[j]);
+        for (BigNatural i=0; i<skips[j]; ++i)
+            drawn.nextInt32();
+        for (Size i=0; i<n; ++i) {
+            unsigned long calculated = skipped.nextInt32(),
+                          expected = drawn.nextInt32();
+            if (calculated != expected)
+                BOOST_FAIL("value #" << i << " after skipping "
+                           << skips[j] << " draws differs:"
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+    }
+}
+
 
 test_suite* MersenneTwisterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &MersenneTwisterTest::testBlocksAndSkipAhead));
     return suite;
 }
 
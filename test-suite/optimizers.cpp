@@ -34,6 +34,10 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/goldstein.hpp>
+#if BOOST_VERSION >= 104700
+#include <ql/experimental/math/particleswarmoptimization.hpp>
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -553,11 +557,97 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+namespace {
+
+    bool sameResults(const Problem& p1, const Problem& p2) {
+        if (p1.functionValue() != p2.functionValue() ||
+            p1.functionEvaluation() != p2.functionEvaluation())
+            return false;
+        for (Size i=0; i<p1.currentValue().size(); ++i)
+            if (p1.currentValue()[i] != p2.currentValue()[i])
+                return false;
+        return true;
+    }
+
+}
+
+void OptimizersTest::testParallelEvaluation() {
+    BOOST_TEST_MESSAGE("Testing parallel evaluation in global optimizers...");
+
+    // random numbers are drawn sequentially, so the results must be
+    // the same whether or not the population is evaluated in parallel
+
+    SecondDeJong costFunction;
+    BoundaryConstraint constraint(-10.0, 10.0);
+    Array initialValue(2, 5.0);
+    EndCriteria endCriteria(50, 10, 1e-10, 1e-8, Null<Real>());
+
+    {
+        DifferentialEvolution::Configuration conf =
+            DifferentialEvolution::Configuration()
+            .withPopulationMembers(50)
+            .withAdaptiveCrossover()
+            .withSeed(3242);
+        DifferentialEvolution serial(conf),
+            parallel(conf.withParallelEvaluation());
+        Problem p1(costFunction, constraint, initialValue),
+                p2(costFunction, constraint, initialValue);
+        serial.minimize(p1, endCriteria);
+        parallel.minimize(p2, endCriteria);
+        if (!sameResults(p1, p2))
+            BOOST_ERROR("different results with parallel evaluation in "
+                        "differential evolution"
+                        << "\n    serial:   " << p1.functionValue()
+                        << "\n    parallel: " << p2.functionValue());
+    }
+
+#if BOOST_VERSION >= 104700
+    {
+        ParticleSwarmOptimization serial(
+            50, boost::make_shared<KNeighbors>(10),
+            boost::make_shared<TrivialInertia>(), 2.05, 2.05, 42, false);
+        ParticleSwarmOptimization parallel(
+            50, boost::make_shared<KNeighbors>(10),
+            boost::make_shared<TrivialInertia>(), 2.05, 2.05, 42, true);
+        Problem p1(costFunction, constraint, initialValue),
+                p2(costFunction, constraint, initialValue);
+        serial.minimize(p1, endCriteria);
+        parallel.minimize(p2, endCriteria);
+        if (!sameResults(p1, p2))
+            BOOST_ERROR("different results with parallel evaluation in "
+                        "particle swarm optimization"
+                        << "\n    serial:   " << p1.functionValue()
+                        << "\n    parallel: " << p2.functionValue());
+    }
+
+    {
+        FireflyAlgorithm serial(
+            50, boost::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+            boost::make_shared<LevyFlightWalk>(1.5, 0.5, 1.0, 42),
+            10, 1.0, 0.5, 42, false);
+        FireflyAlgorithm parallel(
+            50, boost::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+            boost::make_shared<LevyFlightWalk>(1.5, 0.5, 1.0, 42),
+            10, 1.0, 0.5, 42, true);
+        Problem p1(costFunction, constraint, initialValue),
+                p2(costFunction, constraint, initialValue);
+        serial.minimize(p1, endCriteria);
+        parallel.minimize(p2, endCriteria);
+        if (!sameResults(p1, p2))
+            BOOST_ERROR("different results with parallel evaluation in "
+                        "firefly algorithm"
+                        << "\n    serial:   " << p1.functionValue()
+                        << "\n    parallel: " << p2.functionValue());
+    }
+#endif
+}
+
 test_suite* OptimizersTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Optimizers tests");
 
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::test));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::nestedOptimizationTest));
+    suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testParallelEvaluation));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
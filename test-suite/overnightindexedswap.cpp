@@ -34,14 +34,19 @@
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -427,12 +432,221 @@ void OvernightIndexedSwapTest::testBootstrap() {
 }
 
 
+void OvernightIndexedSwapTest::testSeasonedCoupons() {
+
+    BOOST_TEST_MESSAGE("Testing seasoned overnight-indexed coupons...");
+
+    CommonVars vars;
+
+    // the forward part of the coupons starts today
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    vars.eoniaIndex->clearFixings();
+    Date firstFixing = vars.calendar.advance(vars.today, -1, Years);
+    Size k = 0;
+    for (Date d = firstFixing; d < vars.today;
+         d = vars.calendar.advance(d, 1, Days), ++k)
+        vars.eoniaIndex->addFixing(d, 0.02 + 0.0005*(k%7));
+
+    // coupons starting and ending at different dates, so that the
+    // compounded fixings stored by the index are extended both ways
+    Date starts[] = { vars.calendar.advance(vars.today, -3, Months),
+                      vars.calendar.advance(vars.today, -6, Months),
+                      vars.calendar.advance(vars.today, -1, Years),
+                      vars.calendar.advance(vars.today, -2, Months) };
+    Date ends[] = { vars.calendar.advance(vars.today, 3, Months),
+                    vars.calendar.advance(vars.today, -5, Months),
+                    vars.calendar.advance(vars.today, 1, Years),
+                    vars.today };
+
+    for (Size m=0; m<2; ++m) {
+        if (m == 1) {
+            // the stored values must not survive a change of fixings
+            Date d = vars.calendar.advance(vars.today, -4, Months);
+            vars.eoniaIndex->addFixing(d, 0.05, true);
+        }
+        for (Size i=0; i<LENGTH(starts); ++i) {
+            OvernightIndexedCoupon coupon(ends[i], vars.nominal,
+                                          starts[i], ends[i],
+                                          vars.eoniaIndex);
+
+            const std::vector<Date>& dates = coupon.valueDates();
+            const std::vector<Date>& fixingDates = coupon.fixingDates();
+            const std::vector<Time>& dt = coupon.dt();
+            Size n = dt.size(), j = 0;
+            Real compoundFactor = 1.0;
+            for (; j<n && fixingDates[j]<vars.today; ++j)
+                compoundFactor *=
+                    1.0 + vars.eoniaIndex->fixing(fixingDates[j])*dt[j];
+            if (j<n)
+                compoundFactor *=
+                    vars.eoniaTermStructure->discount(dates[j]) /
+                    vars.eoniaTermStructure->discount(dates[n]);
+            Rate expected = (compoundFactor - 1.0) / coupon.accrualPeriod();
+
+            Rate calculated = coupon.rate();
+            if (std::fabs(calculated-expected) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce coupon rate:\n"
+                            << std::setprecision(12)
+                            << "    start:      " << starts[i] << "\n"
+                            << "    end:        " << ends[i] << "\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << expected);
+        }
+    }
+
+    vars.eoniaIndex->clearFixings();
+}
+
+
+void OvernightIndexedSwapTest::testFixingGaps() {
+
+    BOOST_TEST_MESSAGE(
+               "Testing overnight coupons with gaps in the fixing history...");
+
+    CommonVars vars;
+
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    // two past coupons, one month apart
+    Date start1 = vars.calendar.advance(vars.today, -4, Months);
+    Date end1 = vars.calendar.advance(vars.today, -3, Months);
+    Date start2 = vars.calendar.advance(vars.today, -2, Months);
+    Date end2 = vars.calendar.advance(vars.today, -1, Months);
+
+    std::vector<boost::shared_ptr<OvernightIndexedCoupon> > coupons;
+    coupons.push_back(boost::make_shared<OvernightIndexedCoupon>(
+              end2, vars.nominal, start2, end2, vars.eoniaIndex));
+    coupons.push_back(boost::make_shared<OvernightIndexedCoupon>(
+              end1, vars.nominal, start1, end1, vars.eoniaIndex));
+
+    vars.eoniaIndex->clearFixings();
+    for (Size i=0; i<2; ++i) {
+        if (i == 1) {
+            // fill the gap; the coupons spanning it join the
+            // compounded fixings stored for the first two
+            for (Date d = end1; d < start2;
+                 d = vars.calendar.advance(d, 1, Days))
+                vars.eoniaIndex->addFixing(d, 0.03);
+            coupons.push_back(boost::make_shared<OvernightIndexedCoupon>(
+                      end2, vars.nominal, end1, end2, vars.eoniaIndex));
+            coupons.push_back(boost::make_shared<OvernightIndexedCoupon>(
+                      end2, vars.nominal, start1, end2, vars.eoniaIndex));
+        }
+
+        if (i == 0) {
+            // only the fixings required by the coupons are stored
+            for (Size j=0; j<coupons.size(); ++j) {
+                const std::vector<Date>& fixingDates =
+                    coupons[j]->fixingDates();
+                for (Size m=0; m<fixingDates.size(); ++m)
+                    vars.eoniaIndex->addFixing(fixingDates[m],
+                                               0.02 + 0.0005*(m%7));
+            }
+        }
+
+        for (Size j=0; j<coupons.size(); ++j) {
+            const OvernightIndexedCoupon& coupon = *coupons[j];
+            const std::vector<Date>& fixingDates = coupon.fixingDates();
+            const std::vector<Time>& dt = coupon.dt();
+
+            Real compoundFactor = 1.0;
+            for (Size m=0; m<fixingDates.size(); ++m)
+                compoundFactor *=
+                    1.0 + vars.eoniaIndex->fixing(fixingDates[m])*dt[m];
+            Rate expected = (compoundFactor - 1.0) / coupon.accrualPeriod();
+
+            Rate calculated = Null<Rate>();
+            try {
+                calculated = coupon.rate();
+            } catch (std::exception& e) {
+                BOOST_ERROR("failed to calculate coupon rate:\n"
+                            << "    start: " << coupon.accrualStartDate()
+                            << "\n"
+                            << "    end:   " << coupon.accrualEndDate()
+                            << "\n" << e.what());
+                continue;
+            }
+            if (std::fabs(calculated-expected) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce coupon rate:\n"
+                            << std::setprecision(12)
+                            << "    start:      " << coupon.accrualStartDate()
+                            << "\n"
+                            << "    end:        " << coupon.accrualEndDate()
+                            << "\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << expected);
+        }
+    }
+}
+
+
+void OvernightIndexedSwapTest::testClearedFixings() {
+
+    BOOST_TEST_MESSAGE("Testing overnight coupons after clearing fixings...");
+
+    CommonVars vars;
+
+    vars.eoniaTermStructure.linkTo(flatRate(vars.today, 0.05,
+                                            Actual365Fixed()));
+
+    IndexManager& manager = IndexManager::instance();
+    // histories are listed under the upper-case index name
+    std::string name = boost::to_upper_copy(vars.eoniaIndex->name());
+    vars.eoniaIndex->clearFixings();
+
+    Date start = vars.calendar.advance(vars.today, -1, Months);
+    Date end = vars.calendar.advance(vars.today, 1, Months);
+    OvernightIndexedCoupon coupon(end, vars.nominal, start, end,
+                                  vars.eoniaIndex);
+
+    Rate fixings[] = { 0.02, 0.03 };
+    std::vector<Rate> rates;
+    for (Size k=0; k<LENGTH(fixings); ++k) {
+        for (Date d = start; d < vars.today;
+             d = vars.calendar.advance(d, 1, Days))
+            vars.eoniaIndex->addFixing(d, fixings[k]);
+
+        std::vector<std::string> names = manager.histories();
+        if (!manager.hasHistory(name)
+            || std::find(names.begin(), names.end(), name) == names.end())
+            BOOST_ERROR("stored fixings not reported for " << name);
+
+        rates.push_back(coupon.rate());
+
+        vars.eoniaIndex->clearFixings();
+
+        names = manager.histories();
+        if (manager.hasHistory(name))
+            BOOST_ERROR("cleared fixings still reported for " << name);
+        if (std::find(names.begin(), names.end(), name) != names.end())
+            BOOST_ERROR("cleared fixings still listed for " << name);
+        BOOST_CHECK_THROW(coupon.rate(), Error);
+    }
+
+    // the coupon was notified of the new fixings
+    if (rates[1] <= rates[0])
+        BOOST_ERROR("fixings added after clearing were not used:\n"
+                    << std::setprecision(12)
+                    << "    rate with first fixings:  " << rates[0] << "\n"
+                    << "    rate with second fixings: " << rates[1]);
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testCachedValue));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &OvernightIndexedSwapTest::testSeasonedCoupons));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &OvernightIndexedSwapTest::testFixingGaps));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &OvernightIndexedSwapTest::testClearedFixings));
     return suite;
 }
 
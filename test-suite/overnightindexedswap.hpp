@@ -31,6 +31,9 @@ class OvernightIndexedSwapTest {
     static void testFairSpread();
     static void testCachedValue();
     static void testBootstrap();
+    static void testSeasonedCoupons();
+    static void testFixingGaps();
+    static void testClearedFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
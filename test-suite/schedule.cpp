@@ -24,6 +24,9 @@
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -360,6 +363,114 @@ void ScheduleTest::testFourWeeksTenor() {
     }
 }
 
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache& cache = ScheduleCache::instance();
+    cache.clear();
+
+    Date startDate(31,January,2017), endDate(31,January,2027);
+
+    boost::shared_ptr<const Schedule> s1 =
+        cache.schedule(startDate, endDate, 6*Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, true);
+    boost::shared_ptr<const Schedule> s2 =
+        cache.schedule(startDate, endDate, 6*Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, true);
+    if (s1 != s2)
+        BOOST_ERROR("schedule not shared for identical arguments");
+
+    boost::shared_ptr<const Schedule> s3 =
+        cache.schedule(startDate, endDate, 6*Months, Japan(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, true);
+    if (s1 == s3)
+        BOOST_ERROR("schedule shared across different calendars");
+    if (cache.size() != 2)
+        BOOST_ERROR("wrong number of cached schedules: "
+                    << cache.size() << " (expected 2)");
+
+    Schedule expected(startDate, endDate, 6*Months, TARGET(),
+                      ModifiedFollowing, ModifiedFollowing,
+                      DateGeneration::Backward, true);
+    check_dates(*s1, expected.dates());
+
+    Schedule s4 = MakeSchedule().from(startDate).to(endDate)
+                                .withCalendar(TARGET())
+                                .withTenor(6*Months)
+                                .withConvention(ModifiedFollowing)
+                                .endOfMonth()
+                                .cached();
+    check_dates(s4, expected.dates());
+    if (cache.size() != 2)
+        BOOST_ERROR("schedule generated again for identical arguments");
+
+    // calendars with the same name but different holidays
+    BespokeCalendar c1("bespoke"), c2("bespoke");
+    c1.addWeekend(Saturday);
+    c1.addWeekend(Sunday);
+    c2.addWeekend(Saturday);
+    c2.addWeekend(Sunday);
+    c2.addHoliday(Date(31,July,2017));
+    boost::shared_ptr<const Schedule> s5 =
+        cache.schedule(startDate, endDate, 6*Months, c1,
+                       Following, Following, DateGeneration::Forward, false);
+    boost::shared_ptr<const Schedule> s6 =
+        cache.schedule(startDate, endDate, 6*Months, c2,
+                       Following, Following, DateGeneration::Forward, false);
+    if (s5 == s6 || s5->date(1) == s6->date(1))
+        BOOST_ERROR("schedule shared across calendars with the same name");
+
+    // holidays changed after the schedule was stored
+    c1.addHoliday(Date(31,July,2017));
+    boost::shared_ptr<const Schedule> s7 =
+        cache.schedule(startDate, endDate, 6*Months, c1,
+                       Following, Following, DateGeneration::Forward, false);
+    if (s7 == s5 || s7->date(1) != Date(1,August,2017))
+        BOOST_ERROR("outdated schedule returned after holiday change:\n"
+                    << "    second date: " << s7->date(1) << "\n"
+                    << "    expected:    " << Date(1,August,2017));
+    // ...but schedules on other calendars are still shared
+    boost::shared_ptr<const Schedule> s8 =
+        cache.schedule(startDate, endDate, 6*Months, c2,
+                       Following, Following, DateGeneration::Forward, false);
+    if (s8 != s6)
+        BOOST_ERROR("schedule on unchanged calendar not shared "
+                    "after holiday change");
+    c1.removeHoliday(Date(31,July,2017));
+
+    // the number of stored schedules is bounded
+    cache.setCapacity(5);
+    for (Size i=0; i<20; ++i) {
+        cache.schedule(startDate, endDate + i, 6*Months, TARGET(),
+                       Following, Following, DateGeneration::Forward, false);
+        if (cache.size() > 5)
+            BOOST_ERROR("schedule cache exceeded its capacity: "
+                        << cache.size() << " schedules stored");
+    }
+    cache.setCapacity(1000);
+
+    // swaps built with cached schedules share them
+    boost::shared_ptr<IborIndex> index(new Euribor6M);
+    boost::shared_ptr<VanillaSwap> swap1 =
+        MakeVanillaSwap(10*Years, index, 0.02)
+        .withEffectiveDate(startDate)
+        .withCachedSchedules();
+    boost::shared_ptr<VanillaSwap> swap2 =
+        MakeVanillaSwap(10*Years, index, 0.03)
+        .withEffectiveDate(startDate)
+        .withCachedSchedules();
+    if (&swap1->fixedSchedule() != &swap2->fixedSchedule()
+        || &swap1->floatingSchedule() != &swap2->floatingSchedule())
+        BOOST_ERROR("cached schedules copied into swaps");
+
+    cache.clear();
+    if (cache.size() != 0)
+        BOOST_ERROR("schedule cache not cleared");
+}
+
 
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
@@ -378,5 +489,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testCDS2015Convention));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDateConstructor));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFourWeeksTenor));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
@@ -50,6 +50,43 @@ namespace {
         Volatility volatility;
     };
 
+    class FailingSwaptionEngine
+        : public GenericEngine<Swaption::arguments, Swaption::results> {
+      public:
+        void calculate() const { QL_FAIL("swaption pricing failed"); }
+    };
+
+    std::vector<boost::shared_ptr<CalibrationHelper> >
+    swaptionHelpers(const boost::shared_ptr<HullWhite>& model,
+                    const Handle<YieldTermStructure>& termStructure,
+                    bool separateEngines) {
+        CalibrationData data[] = {{ 1, 5, 0.1148 },
+                                  { 2, 4, 0.1108 },
+                                  { 3, 3, 0.1070 },
+                                  { 4, 2, 0.1021 },
+                                  { 5, 1, 0.1000 }};
+        boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+        boost::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+        std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+        for (Size i=0; i<LENGTH(data); i++) {
+            boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            if (separateEngines)
+                engine = boost::shared_ptr<PricingEngine>(
+                                         new JamshidianSwaptionEngine(model));
+            helper->setPricingEngine(engine);
+            swaptions.push_back(helper);
+        }
+        return swaptions;
+    }
+
 }
 
 
@@ -287,6 +324,159 @@ void ShortRateModelTest::testCachedHullWhite2() {
     }
 }
 
+void ShortRateModelTest::testHullWhiteAnalyticGradient() {
+    BOOST_TEST_MESSAGE("Testing Hull-White swaption helper gradients "
+                       "and calibration with analytic jacobian...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure,0.05,0.01));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    boost::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+        helper->setPricingEngine(engine);
+        swaptions.push_back(helper);
+    }
+
+    // central differences with a relative bump of 1e-4 are accurate
+    // to about 1e-7 here, so the analytic gradient must match them
+    // to within 1bp in relative terms
+    const Real relativeBump = 1.0e-4, tolerance = 1.0e-4;
+    const Array params = model->params();
+    for (Size i=0; i<swaptions.size(); i++) {
+        if (!swaptions[i]->hasAnalyticGradient())
+            BOOST_FAIL("analytic gradient expected to be available");
+        Array gradient;
+        Real value = swaptions[i]->modelValueAndGradient(gradient);
+        if (std::fabs(value - swaptions[i]->modelValue()) > 1.0e-12)
+            BOOST_ERROR("value from gradient calculation ("
+                        << value << ") differs from model value ("
+                        << swaptions[i]->modelValue() << ")");
+        for (Size j=0; j<params.size(); j++) {
+            Real h = relativeBump*params[j];
+            Array bumped(params);
+            bumped[j] = params[j] + h;
+            model->setParams(bumped);
+            Real up = swaptions[i]->modelValue();
+            bumped[j] = params[j] - h;
+            model->setParams(bumped);
+            Real down = swaptions[i]->modelValue();
+            model->setParams(params);
+            Real expected = (up - down)/(2.0*h);
+            if (std::fabs(gradient[j] - expected) >
+                                tolerance*std::fabs(expected))
+                BOOST_ERROR("failed to reproduce finite difference gradient"
+                            << std::setprecision(12)
+                            << "\n    helper:     " << i
+                            << "\n    parameter:  " << j
+                            << "\n    analytic:   " << gradient[j]
+                            << "\n    numerical:  " << expected);
+        }
+    }
+
+    // the calibration with the analytic jacobian must reproduce
+    // the results of testCachedHullWhite
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8,true);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+    model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+    #if defined(QL_USE_INDEXED_COUPON)
+    Real cachedA = 0.0463679, cachedSigma = 0.00579831;
+    #else
+    Real cachedA = 0.0464041, cachedSigma = 0.00579912;
+    #endif
+    Array calculated = model->params();
+    if (std::fabs(calculated[0]-cachedA) > 1.0e-5
+        || std::fabs(calculated[1]-cachedSigma) > 1.0e-5) {
+        BOOST_ERROR("Failed to reproduce cached calibration results:\n"
+                    << "calculated: a = " << calculated[0] << ", "
+                    << "sigma = " << calculated[1] << ",\n"
+                    << "expected:   a = " << cachedA << ", "
+                    << "sigma = " << cachedSigma);
+    }
+}
+
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with helpers "
+                       "repriced concurrently...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+
+    // with QL_ENABLE_PARALLEL_CALIBRATION, helpers with separate
+    // engines are repriced concurrently, while helpers sharing an
+    // engine are repriced serially
+    boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+    boost::shared_ptr<HullWhite> parallelModel(new HullWhite(termStructure));
+    std::vector<boost::shared_ptr<CalibrationHelper> > serialHelpers =
+        swaptionHelpers(serialModel, termStructure, false);
+    std::vector<boost::shared_ptr<CalibrationHelper> > parallelHelpers =
+        swaptionHelpers(parallelModel, termStructure, true);
+
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    serialModel->calibrate(serialHelpers, optimizationMethod, endCriteria);
+    parallelModel->calibrate(parallelHelpers, optimizationMethod,
+                             endCriteria);
+
+    Array serial = serialModel->params(), parallel = parallelModel->params();
+    for (Size i=0; i<serial.size(); i++) {
+        if (std::fabs(serial[i] - parallel[i]) > 1.0e-12)
+            BOOST_ERROR("failed to reproduce serial calibration:"
+                        << std::setprecision(12)
+                        << "\n    parameter: " << i
+                        << "\n    serial:    " << serial[i]
+                        << "\n    parallel:  " << parallel[i]);
+    }
+
+    // an error in a single helper must reach the caller
+    boost::shared_ptr<CalibrationHelper> failing =
+        swaptionHelpers(parallelModel, termStructure, true)[2];
+    failing->setPricingEngine(
+                boost::shared_ptr<PricingEngine>(new FailingSwaptionEngine));
+    parallelHelpers[2] = failing;
+    std::string message;
+    try {
+        parallelModel->calibrate(parallelHelpers, optimizationMethod,
+                                 endCriteria);
+    } catch (Error& e) {
+        message = e.what();
+    }
+    if (message.find("swaption pricing failed") == std::string::npos)
+        BOOST_ERROR("failed to propagate pricing error from calibration "
+                    "helper (message: \"" << message << "\")");
+}
+
 void ShortRateModelTest::testSwaps() {
     BOOST_TEST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
@@ -433,6 +623,10 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &ShortRateModelTest::testHullWhiteAnalyticGradient));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &ShortRateModelTest::testParallelCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
 
     if (speed == Slow) {
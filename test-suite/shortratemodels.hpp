@@ -32,6 +32,8 @@ class ShortRateModelTest {
     static void testCachedHullWhite();
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
+    static void testHullWhiteAnalyticGradient();
+    static void testParallelCalibration();
     static void testSwaps();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
@@ -24,9 +24,11 @@
 #include "utilities.hpp"
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/meanvariancestatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -327,7 +329,7 @@ void StatisticsTest::testConvergenceStatistics() {
 }
 
 #define TEST_INC_STAT(expr, expected)                                          \
-    if (!close_enough(expr, expected))                                         \
+    if (std::fabs((expr) - (expected)) > 1.0e-12 * std::fabs(expected))        \
         BOOST_ERROR(std::setprecision(16)                                      \
                     << std::scientific << #expr << " (" << expr                \
                     << ") can not be reproduced against cached result ("       \
@@ -337,10 +339,10 @@ void StatisticsTest::testIncrementalStatistics() {
 
     BOOST_TEST_MESSAGE("Testing incremental statistics...");
 
-    // With QuantLib 1.7 IncrementalStatistics was changed to
-    // a wrapper to the boost accumulator library. This is
-    // a test of the new implementation against results from
-    // the old one.
+    // The results below were obtained with the implementation
+    // based on the boost accumulator library (QuantLib 1.7 to
+    // 1.11); the current one updates the central moments
+    // directly, so they are reproduced up to round-off.
 
     MersenneTwisterUniformRng mt(42);
 
@@ -389,11 +391,275 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+namespace {
+
+    template <class S>
+    S mergedStatistics(const std::vector<Real>& x,
+                       const std::vector<Real>& w, Size split) {
+        S s1, s2;
+        for (Size i=0; i<split; ++i)
+            s1.add(x[i], w[i]);
+        for (Size i=split; i<x.size(); ++i)
+            s2.add(x[i], w[i]);
+        s1.merge(s2);
+        return s1;
+    }
+
+}
+
+#define TEST_MERGED_STAT(name, expr)                                           \
+    if (std::fabs(merged.expr - whole.expr)                                    \
+        > 1.0e-10 * std::max<Real>(1.0, std::fabs(whole.expr)))               \
+        BOOST_ERROR(name << ": merged " << #expr << " (" << merged.expr      \
+                    << ") differs from the one of the whole data ("           \
+                    << whole.expr << ")");
+
+void StatisticsTest::testMerge() {
+
+    BOOST_TEST_MESSAGE("Testing merge of statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    const Size n = 10000, split = 3456;
+    std::vector<Real> x(n), w(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = 1.0e4 + 2.0 * (mt.nextReal() - 0.4) * 123.0;
+        w[i] = mt.nextReal();
+    }
+    // ensure some negative data for the downside statistics
+    for (Size i=0; i<n; i+=7)
+        x[i] = -std::fabs(x[i]) / 10.0;
+
+    {
+        IncrementalStatistics whole;
+        whole.addSequence(x.begin(), x.end(), w.begin());
+        IncrementalStatistics merged =
+            mergedStatistics<IncrementalStatistics>(x, w, split);
+        std::string name = "IncrementalStatistics";
+        TEST_MERGED_STAT(name, samples());
+        TEST_MERGED_STAT(name, weightSum());
+        TEST_MERGED_STAT(name, mean());
+        TEST_MERGED_STAT(name, variance());
+        TEST_MERGED_STAT(name, skewness());
+        TEST_MERGED_STAT(name, kurtosis());
+        TEST_MERGED_STAT(name, min());
+        TEST_MERGED_STAT(name, max());
+        TEST_MERGED_STAT(name, downsideVariance());
+
+        // merging with an empty instance is a no-op
+        IncrementalStatistics empty;
+        merged.merge(empty);
+        TEST_MERGED_STAT(name, samples());
+        TEST_MERGED_STAT(name, variance());
+        empty.merge(whole);
+        if (empty.samples() != whole.samples()
+            || std::fabs(empty.mean() - whole.mean()) > 1.0e-12)
+            BOOST_ERROR(name << ": merge into empty instance failed");
+    }
+
+    {
+        Statistics whole;
+        whole.addSequence(x.begin(), x.end(), w.begin());
+        Statistics merged = mergedStatistics<Statistics>(x, w, split);
+        std::string name = "Statistics";
+        TEST_MERGED_STAT(name, samples());
+        TEST_MERGED_STAT(name, weightSum());
+        TEST_MERGED_STAT(name, mean());
+        TEST_MERGED_STAT(name, variance());
+        TEST_MERGED_STAT(name, skewness());
+        TEST_MERGED_STAT(name, kurtosis());
+        TEST_MERGED_STAT(name, percentile(0.9));
+        TEST_MERGED_STAT(name, downsideVariance());
+    }
+
+    {
+        MeanVarianceStatistics whole;
+        whole.addSequence(x.begin(), x.end(), w.begin());
+        MeanVarianceStatistics merged =
+            mergedStatistics<MeanVarianceStatistics>(x, w, split);
+        std::string name = "MeanVarianceStatistics";
+        TEST_MERGED_STAT(name, samples());
+        TEST_MERGED_STAT(name, weightSum());
+        TEST_MERGED_STAT(name, mean());
+        TEST_MERGED_STAT(name, variance());
+        TEST_MERGED_STAT(name, errorEstimate());
+
+        IncrementalStatistics reference;
+        reference.addSequence(x.begin(), x.end(), w.begin());
+        if (std::fabs(whole.variance() - reference.variance())
+            > 1.0e-10 * reference.variance())
+            BOOST_ERROR(name << ": variance (" << whole.variance()
+                        << ") differs from IncrementalStatistics ("
+                        << reference.variance() << ")");
+    }
+
+    {
+        const Size dimension = 3;
+        SequenceStatistics whole(dimension), first(dimension),
+                           second(dimension);
+        std::vector<Real> sample(dimension);
+        for (Size i=0; i+dimension<=n; i+=dimension) {
+            for (Size j=0; j<dimension; ++j)
+                sample[j] = x[i+j];
+            whole.add(sample, w[i]);
+            if (i < split)
+                first.add(sample, w[i]);
+            else
+                second.add(sample, w[i]);
+        }
+        first.merge(second);
+        std::vector<Real> mean = whole.mean(), mergedMean = first.mean();
+        Matrix covariance = whole.covariance(),
+               mergedCovariance = first.covariance();
+        if (first.samples() != whole.samples())
+            BOOST_ERROR("SequenceStatistics: merged samples ("
+                        << first.samples() << ") differ from those of "
+                        "the whole data (" << whole.samples() << ")");
+        for (Size i=0; i<dimension; ++i) {
+            if (std::fabs(mergedMean[i] - mean[i]) > 1.0e-10*std::fabs(mean[i]))
+                BOOST_ERROR("SequenceStatistics: merged mean["
+                            << i << "] (" << mergedMean[i] << ") differs "
+                            "from the one of the whole data ("
+                            << mean[i] << ")");
+            for (Size j=0; j<dimension; ++j) {
+                if (std::fabs(mergedCovariance[i][j] - covariance[i][j])
+                    > 1.0e-10*std::fabs(covariance[i][i]))
+                    BOOST_ERROR("SequenceStatistics: merged covariance["
+                                << i << "][" << j << "] ("
+                                << mergedCovariance[i][j] << ") differs "
+                                "from the one of the whole data ("
+                                << covariance[i][j] << ")");
+            }
+        }
+    }
+
+    {
+        ConvergenceStatistics<IncrementalStatistics> first, second;
+        for (Size i=0; i<100; ++i)
+            first.add(x[i], w[i]);
+        for (Size i=100; i<300; ++i)
+            second.add(x[i], w[i]);
+        first.merge(second);
+        const std::vector<std::pair<Size,Real> >& table =
+            first.convergenceTable();
+        if (first.samples() != 300)
+            BOOST_ERROR("ConvergenceStatistics: merged samples ("
+                        << first.samples() << ") differ from those of "
+                        "the whole data (300)");
+        if (table.empty() || table.back().first != 300)
+            BOOST_ERROR("ConvergenceStatistics: "
+                        "no table entry added for merged data");
+        else if (std::fabs(table.back().second - first.mean()) > 1.0e-12)
+            BOOST_ERROR("ConvergenceStatistics: wrong table entry ("
+                        << table.back().second << ") for merged data "
+                        "(expected " << first.mean() << ")");
+    }
+}
+
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal(mt);
+
+    const Size n = 200000, split = 76543;
+    const Real compression = 200.0;
+    const Size tailSize = n/50;
+    std::vector<Real> data(n);
+    for (Size i=0; i<n; ++i)
+        data[i] = normal.next().value;
+
+    RiskStatistics reference;
+    reference.addSequence(data.begin(), data.end());
+    std::vector<Real> sorted(data);
+    std::sort(sorted.begin(), sorted.end());
+
+    StreamingStatistics digest(compression);
+    digest.addSequence(data.begin(), data.end());
+
+    if (digest.samples() != n)
+        BOOST_ERROR("wrong number of samples\n"
+                    << "    calculated: " << digest.samples() << "\n"
+                    << "    expected:   " << n);
+    if (std::fabs(digest.mean() - reference.mean()) > 1.0e-12)
+        BOOST_ERROR("wrong mean\n"
+                    << std::setprecision(12)
+                    << "    calculated: " << digest.mean() << "\n"
+                    << "    expected:   " << reference.mean());
+    if (digest.centroids() > Size(compression))
+        BOOST_ERROR("too many centroids (" << digest.centroids()
+                    << ") for compression " << compression);
+
+    // the rank of the returned percentiles must be within the bound
+    Real percentiles[] = { 0.001, 0.01, 0.05, 0.25, 0.5,
+                           0.75, 0.95, 0.99, 0.999 };
+    for (Size i=0; i<LENGTH(percentiles); ++i) {
+        Real q = percentiles[i];
+        Real tolerance = 2.0*M_PI*std::sqrt(q*(1.0-q))/compression;
+        Real x = digest.percentile(q);
+        Real rank = Real(std::lower_bound(sorted.begin(), sorted.end(), x)
+                         - sorted.begin()) / n;
+        if (std::fabs(rank - q) > tolerance)
+            BOOST_ERROR("percentile " << q << " out of bounds\n"
+                        << std::setprecision(6)
+                        << "    calculated: " << x << "\n"
+                        << "    rank:       " << rank << "\n"
+                        << "    tolerance:  " << tolerance);
+        x = digest.topPercentile(1.0-q);
+        rank = Real(std::lower_bound(sorted.begin(), sorted.end(), x)
+                    - sorted.begin()) / n;
+        if (std::fabs(rank - q) > tolerance)
+            BOOST_ERROR("top percentile " << 1.0-q << " out of bounds\n"
+                        << std::setprecision(6)
+                        << "    calculated: " << x << "\n"
+                        << "    rank:       " << rank << "\n"
+                        << "    tolerance:  " << tolerance);
+    }
+
+    // when the tail retains enough samples, value-at-risk and expected
+    // shortfall must be the same returned by RiskStatistics, also
+    // after merging
+    StreamingRiskStatistics whole(StreamingStatistics(compression,
+                                                      tailSize));
+    whole.addSequence(data.begin(), data.end());
+    StreamingRiskStatistics merged(StreamingStatistics(compression,
+                                                       tailSize)),
+                            other(StreamingStatistics(compression,
+                                                      tailSize));
+    merged.addSequence(data.begin(), data.begin()+split);
+    other.addSequence(data.begin()+split, data.end());
+    merged.merge(other);
+
+    Real levels[] = { 0.985, 0.99, 0.995, 0.999 };
+    for (Size i=0; i<LENGTH(levels); ++i) {
+        Real expectedVaR = reference.valueAtRisk(levels[i]);
+        Real expectedES = reference.expectedShortfall(levels[i]);
+        Real calculated[] = { whole.valueAtRisk(levels[i]),
+                              merged.valueAtRisk(levels[i]),
+                              whole.expectedShortfall(levels[i]),
+                              merged.expectedShortfall(levels[i]) };
+        for (Size j=0; j<LENGTH(calculated); ++j) {
+            bool isVaR = j < 2;
+            Real expected = isVaR ? expectedVaR : expectedES;
+            if (std::fabs(calculated[j] - expected) > 1.0e-12)
+                BOOST_ERROR((j % 2 == 0 ? "" : "merged ")
+                            << (isVaR ? "value-at-risk" : "expected shortfall")
+                            << " at " << levels[i] << " not reproduced\n"
+                            << std::setprecision(12)
+                            << "    calculated: " << calculated[j] << "\n"
+                            << "    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMerge));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }
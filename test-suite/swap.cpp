@@ -35,6 +35,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -322,6 +323,72 @@ void SwapTest::testCachedValue() {
 }
 
 
+void SwapTest::testSharedIndexForecasts() {
+
+    BOOST_TEST_MESSAGE("Testing swaps sharing an index after curve changes...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.05));
+    vars.termStructure.linkTo(flatRate(vars.settlement, rate,
+                                       Actual365Fixed()));
+
+    Integer lengths[] = { 1, 2, 5, 10, 20 };
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    for (Size i=0; i<LENGTH(lengths); i++)
+        swaps.push_back(vars.makeSwap(lengths[i], 0.04, 0.0));
+
+    for (Size k=0; k<3; k++) {
+        switch (k) {
+          case 1:
+            rate->setValue(0.06);
+            break;
+          case 2:
+            vars.termStructure.linkTo(flatRate(vars.settlement, 0.03,
+                                               Actual365Fixed()));
+            break;
+        }
+        // the forecasts stored by the shared index must not survive
+        // the change; the results are compared with those obtained
+        // from a new index
+        boost::shared_ptr<IborIndex> index = vars.index;
+        vars.index = index->clone(vars.termStructure);
+        for (Size i=0; i<LENGTH(lengths); i++) {
+            Real calculated = swaps[i]->floatingLegNPV();
+            Real expected =
+                vars.makeSwap(lengths[i], 0.04, 0.0)->floatingLegNPV();
+            if (std::fabs(calculated-expected) > 1.0e-10)
+                BOOST_ERROR("floating-leg NPV not updated:\n"
+                            << std::setprecision(12)
+                            << "    length:     " << lengths[i] << " years\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << expected);
+        }
+        vars.index = index;
+    }
+
+    // the stored forecasts must not survive relinking the curve,
+    // even if the index is not notified of it
+    Date fixingDate =
+        vars.index->fixingCalendar().adjust(vars.settlement + 1*Years);
+    Rate oldFixing = vars.index->fixing(fixingDate);
+    ObservableSettings::instance().disableUpdates();
+    vars.termStructure.linkTo(flatRate(vars.settlement, 0.07,
+                                       Actual365Fixed()));
+    Rate newFixing = vars.index->fixing(fixingDate);
+    ObservableSettings::instance().enableUpdates();
+    Rate expectedFixing =
+        vars.index->clone(vars.termStructure)->fixing(fixingDate);
+    if (newFixing == oldFixing
+        || std::fabs(newFixing-expectedFixing) > 1.0e-12)
+        BOOST_ERROR("forecast fixing not updated after relinking curve:\n"
+                    << std::setprecision(12)
+                    << "    old fixing: " << oldFixing << "\n"
+                    << "    calculated: " << newFixing << "\n"
+                    << "    expected:   " << expectedFixing);
+}
+
+
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
@@ -330,6 +397,7 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSharedIndexForecasts));
     return suite;
 }
 
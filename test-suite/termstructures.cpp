@@ -25,6 +25,10 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/materializedtermstructure.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -334,6 +338,124 @@ void TermStructureTest::testLinkToNullUnderlying() {
     underlying.linkTo(boost::shared_ptr<YieldTermStructure>());
 }
 
+void TermStructureTest::testBatchDiscounts() {
+
+    BOOST_TEST_MESSAGE("Testing batch calculation of discount factors...");
+
+    CommonVars vars;
+
+    Date today = vars.termStructure->referenceDate();
+    DayCounter dc = Actual360();
+    std::vector<Date> nodes;
+    std::vector<Real> dfs, zeros;
+    for (Size i=0; i<=10; ++i) {
+        nodes.push_back(today + Period(3*i*i, Months));
+        dfs.push_back(std::exp(-0.03*i - 0.001*i*i));
+        zeros.push_back(0.02 + 0.002*i - 0.0001*i*i);
+    }
+
+    std::vector<Handle<Quote> > jumps(1,
+        Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.999))));
+    std::vector<Date> jumpDates(1, today + 2*Years);
+
+    boost::shared_ptr<YieldTermStructure> curves[] = {
+        vars.termStructure,
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(nodes, dfs, dc)),
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<Cubic>(nodes, dfs, dc)),
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedZeroCurve<Linear>(nodes, zeros, dc)),
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(
+                nodes, dfs, dc, Calendar(), jumps, jumpDates)),
+        boost::shared_ptr<YieldTermStructure>(
+            new ZeroSpreadedTermStructure(
+                Handle<YieldTermStructure>(vars.termStructure),
+                Handle<Quote>(boost::shared_ptr<Quote>(
+                                                new SimpleQuote(0.01)))))
+    };
+
+    // sorted and unsorted times, including the reference date
+    // and the extrapolation region
+    std::vector<Date> dates;
+    for (Integer i=0; i<400; ++i)
+        dates.push_back(today + i*29);
+    for (Integer i=0; i<50; ++i)
+        dates.push_back(today + ((i*7919) % 12000));
+
+    Real tolerance = 1.0e-12;
+    for (Size k=0; k<LENGTH(curves); ++k) {
+        curves[k]->enableExtrapolation();
+        std::vector<DiscountFactor> calculated(dates.size());
+        curves[k]->discounts(dates, &calculated[0]);
+        for (Size i=0; i<dates.size(); ++i) {
+            DiscountFactor expected = curves[k]->discount(dates[i]);
+            if (std::fabs(calculated[i]-expected) > tolerance)
+                BOOST_ERROR("batch discount factor mismatch for curve #"
+                            << k << " at " << dates[i] << ":\n"
+                            << std::setprecision(12)
+                            << "    calculated: " << calculated[i] << "\n"
+                            << "    expected:   " << expected);
+        }
+    }
+}
+
+void TermStructureTest::testMaterialized() {
+
+    BOOST_TEST_MESSAGE("Testing materialized term structure...");
+
+    CommonVars vars;
+
+    Date today = Settings::instance().evaluationDate();
+    boost::shared_ptr<SimpleQuote> zeroSpread(new SimpleQuote(0.01));
+    boost::shared_ptr<SimpleQuote> forwardSpread(new SimpleQuote(0.002));
+
+    Handle<YieldTermStructure> implied(boost::shared_ptr<YieldTermStructure>(
+        new ImpliedTermStructure(Handle<YieldTermStructure>(vars.termStructure),
+                                 today + 1*Years)));
+    Handle<YieldTermStructure> forwardSpreaded(
+        boost::shared_ptr<YieldTermStructure>(
+            new ForwardSpreadedTermStructure(implied,
+                                             Handle<Quote>(forwardSpread))));
+    Handle<YieldTermStructure> chain(boost::shared_ptr<YieldTermStructure>(
+        new ZeroSpreadedTermStructure(forwardSpreaded,
+                                      Handle<Quote>(zeroSpread))));
+
+    Real accuracy = 1.0e-4;
+    boost::shared_ptr<YieldTermStructure> materialized(
+        new MaterializedTermStructure(chain, 1*Weeks, 60*Years, accuracy));
+
+    Flag flag;
+    flag.registerWith(materialized);
+
+    for (Size k=0; k<2; ++k) {
+        Date maxDate = materialized->maxDate();
+        if (maxDate != chain->maxDate())
+            BOOST_ERROR("wrong max date:\n"
+                        << "    calculated: " << maxDate << "\n"
+                        << "    expected:   " << chain->maxDate());
+        for (Date d = chain->referenceDate(); d < maxDate; d += 17) {
+            DiscountFactor calculated = materialized->discount(d);
+            DiscountFactor expected = chain->discount(d);
+            if (std::fabs(calculated/expected - 1.0) > accuracy)
+                BOOST_ERROR("unable to reproduce discount factor at " << d
+                            << std::setprecision(10) << ":\n"
+                            << "    calculated: " << calculated << "\n"
+                            << "    expected:   " << expected);
+        }
+
+        zeroSpread->setValue(zeroSpread->value() + 0.01);
+        if (!flag.isUp())
+            BOOST_ERROR("Observer was not notified of spread change");
+        flag.lower();
+    }
+
+    boost::shared_ptr<YieldTermStructure> coarse(
+        new MaterializedTermStructure(chain, 5*Years, 60*Years, 1.0e-10));
+    BOOST_CHECK_THROW(coarse->discount(1.0), Error);
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -347,6 +469,8 @@ test_suite* TermStructureTest::suite() {
                          &TermStructureTest::testCreateWithNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                              &TermStructureTest::testLinkToNullUnderlying));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchDiscounts));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testMaterialized));
     return suite;
 }
 
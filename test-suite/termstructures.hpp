@@ -36,6 +36,8 @@ class TermStructureTest {
     static void testZSpreadedObs();
     static void testCreateWithNullUnderlying();
     static void testLinkToNullUnderlying();
+    static void testBatchDiscounts();
+    static void testMaterialized();
     static boost::unit_test_framework::test_suite* suite();
 };
 